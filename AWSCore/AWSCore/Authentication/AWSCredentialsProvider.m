@@ -15,6 +15,7 @@
 
 #import "AWSCredentialsProvider.h"
 #import "AWSSTS.h"
+#import "AWSSignature.h"
 #import "AWSUICKeyChainStore.h"
 #import "AWSLogging.h"
 #import "AWSBolts.h"
@@ -637,6 +638,10 @@ NSString *const AWSCredentialsProviderKeychainIdentityId = @"identityId";
 
 - (void)setSecretKey:(NSString *)secretKey {
     @synchronized(self) {
+        //the keys derived from the previous secret will not be used again.
+        if (_secretKey && ![_secretKey isEqualToString:secretKey]) {
+            [AWSSignatureV4Signer removeDerivedKeysForSecret:_secretKey];
+        }
         _secretKey = secretKey;
         self.keychain[AWSCredentialsProviderKeychainSecretAccessKey] = secretKey;
     }
@@ -29,6 +29,7 @@ FOUNDATION_EXPORT NSString *const AWSSignatureV4Terminator;
 + (NSString *)hashString:(NSString *)stringToHash;
 + (NSData *)hash:(NSData *)dataToHash;
 + (NSString *)hexEncode:(NSString *)string;
++ (NSString *)hexEncodeData:(NSData *)data;
 + (NSString *)HMACSign:(NSData *)data withKey:(NSString *)key usingAlgorithm:(uint32_t)algorithm;
 
 @end
@@ -54,6 +55,11 @@ FOUNDATION_EXPORT NSString *const AWSSignatureV4Terminator;
                      region:(NSString *)regionName
                     service:(NSString *)serviceName;
 
+/**
+ Removes the cached derived keys of the secret. Credentials providers call it when their secret key is replaced.
+ */
++ (void)removeDerivedKeysForSecret:(NSString *)secret;
+
 + (NSString *)getSignedHeadersString:(NSDictionary *)headers;
 
 @end
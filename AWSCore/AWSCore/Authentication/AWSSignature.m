@@ -25,6 +25,18 @@
 NSString *const AWSSigV4Marker = @"AWS4";
 NSString *const AWSSignatureV4Algorithm = @"AWS4-HMAC-SHA256";
 NSString *const AWSSignatureV4Terminator = @"aws4_request";
+NSUInteger const AWSSignatureV4DerivedKeyCacheLimit = 64;
+
+static NSMutableDictionary *_derivedKeys = nil;
+
+static const char AWSSignatureHexDigits[] = "0123456789abcdef";
+
+static void AWSSignatureHexEncodeBytes(const unsigned char *bytes, NSUInteger length, char *hex) {
+    for (NSUInteger i = 0; i < length; i++) {
+        hex[i * 2] = AWSSignatureHexDigits[bytes[i] >> 4];
+        hex[i * 2 + 1] = AWSSignatureHexDigits[bytes[i] & 0x0F];
+    }
+}
 
 @implementation AWSSignatureSignerUtility
 
@@ -66,16 +78,35 @@ NSString *const AWSSignatureV4Terminator = @"aws4_request";
 
     [string getCharacters:chars];
 
-    NSMutableString *hexString = [NSMutableString new];
+    // Digests decoded as ASCII only hold characters up to 0xFF, which take two hex digits each; anything larger takes up to four.
+    char *hex = malloc(len * 4 + 1);
+    NSUInteger hexLength = 0;
     for (NSUInteger i = 0; i < len; i++) {
-        if ((int)chars[i] < 16) {
-            [hexString appendString:@"0"];
+        if (chars[i] <= 0xFF) {
+            unsigned char byte = (unsigned char)chars[i];
+            AWSSignatureHexEncodeBytes(&byte, 1, hex + hexLength);
+            hexLength += 2;
+        } else {
+            hexLength += snprintf(hex + hexLength, 5, "%x", chars[i]);
         }
-        [hexString appendString:[NSString stringWithFormat:@"%x", chars[i]]];
     }
     free(chars);
 
-    return hexString;
+    return [[NSString alloc] initWithBytesNoCopy:hex
+                                          length:hexLength
+                                        encoding:NSASCIIStringEncoding
+                                    freeWhenDone:YES];
+}
+
++ (NSString *)hexEncodeData:(NSData *)data {
+    NSUInteger length = [data length];
+    char *hex = malloc(length * 2);
+    AWSSignatureHexEncodeBytes([data bytes], length, hex);
+
+    return [[NSString alloc] initWithBytesNoCopy:hex
+                                          length:length * 2
+                                        encoding:NSASCIIStringEncoding
+                                    freeWhenDone:YES];
 }
 
 + (NSString *)HMACSign:(NSData *)data withKey:(NSString *)key usingAlgorithm:(CCHmacAlgorithm)algorithm {
@@ -120,8 +151,202 @@ NSString *const AWSSignatureV4Terminator = @"aws4_request";
 
 @property (nonatomic, strong) AWSEndpoint *endpoint;
 
++ (NSString *)getCanonicalizedQueryString:(NSString *)query;
+
 @end
 
+#pragma mark - Canonical request hashing
+
+// The canonical request is never materialized; its bytes are staged in a small buffer and fed straight into the SHA-256 context.
+typedef struct {
+    CC_SHA256_CTX context;
+    NSUInteger length;
+    unsigned char buffer[1024];
+} AWSSignatureSHA256Stream;
+
+// Whitespace in the header block is collapsed to a single space, and whitespace before the first header is dropped.
+typedef NS_ENUM(NSInteger, AWSSignatureWhitespaceState) {
+    AWSSignatureWhitespaceStateLeading,
+    AWSSignatureWhitespaceStateNone,
+    AWSSignatureWhitespaceStatePending,
+};
+
+static void AWSSignatureSHA256StreamFlush(AWSSignatureSHA256Stream *stream) {
+    if (stream->length > 0) {
+        CC_SHA256_Update(&stream->context, stream->buffer, (CC_LONG)stream->length);
+        stream->length = 0;
+    }
+}
+
+static inline void AWSSignatureSHA256StreamAppendByte(AWSSignatureSHA256Stream *stream, unsigned char byte) {
+    if (stream->length == sizeof(stream->buffer)) {
+        AWSSignatureSHA256StreamFlush(stream);
+    }
+    stream->buffer[stream->length++] = byte;
+}
+
+static void AWSSignatureSHA256StreamAppendString(AWSSignatureSHA256Stream *stream, NSString *string) {
+    NSRange remainingRange = NSMakeRange(0, [string length]);
+    while (remainingRange.length > 0) {
+        NSUInteger usedLength = 0;
+        [string getBytes:stream->buffer + stream->length
+               maxLength:sizeof(stream->buffer) - stream->length
+              usedLength:&usedLength
+                encoding:NSUTF8StringEncoding
+                 options:0
+                   range:remainingRange
+          remainingRange:&remainingRange];
+        if (usedLength == 0) {
+            if (stream->length == 0) {
+                // The remaining characters can not be encoded in UTF-8.
+                break;
+            }
+            // Not enough room left for the next character.
+            AWSSignatureSHA256StreamFlush(stream);
+            continue;
+        }
+        stream->length += usedLength;
+    }
+}
+
+static inline void AWSSignatureSHA256StreamAppendCharacter(AWSSignatureSHA256Stream *stream, unsigned char character, BOOL lowercase, AWSSignatureWhitespaceState *whitespaceState) {
+    if (character == ' ' || character == '\t') {
+        if (*whitespaceState != AWSSignatureWhitespaceStateLeading) {
+            *whitespaceState = AWSSignatureWhitespaceStatePending;
+        }
+        return;
+    }
+    if (*whitespaceState == AWSSignatureWhitespaceStatePending) {
+        AWSSignatureSHA256StreamAppendByte(stream, ' ');
+    }
+    *whitespaceState = AWSSignatureWhitespaceStateNone;
+    if (lowercase && character >= 'A' && character <= 'Z') {
+        character += 'a' - 'A';
+    }
+    AWSSignatureSHA256StreamAppendByte(stream, character);
+}
+
+static void AWSSignatureSHA256StreamAppendHeaderString(AWSSignatureSHA256Stream *stream, NSString *string, BOOL lowercase, AWSSignatureWhitespaceState *whitespaceState) {
+    unsigned char characters[256];
+    NSRange remainingRange = NSMakeRange(0, [string length]);
+    while (remainingRange.length > 0) {
+        NSUInteger usedLength = 0;
+        [string getBytes:characters
+               maxLength:sizeof(characters)
+              usedLength:&usedLength
+                encoding:NSASCIIStringEncoding
+                 options:0
+                   range:remainingRange
+          remainingRange:&remainingRange];
+        for (NSUInteger i = 0; i < usedLength; i++) {
+            AWSSignatureSHA256StreamAppendCharacter(stream, characters[i], lowercase, whitespaceState);
+        }
+
+        if (usedLength == 0 && remainingRange.length > 0) {
+            // Non-ASCII characters are rare in headers; they are handled one composed character at a time.
+            NSRange characterRange = [string rangeOfComposedCharacterSequenceAtIndex:remainingRange.location];
+            NSString *character = [string substringWithRange:characterRange];
+            if ([[NSCharacterSet whitespaceCharacterSet] characterIsMember:[character characterAtIndex:0]]) {
+                if (*whitespaceState != AWSSignatureWhitespaceStateLeading) {
+                    *whitespaceState = AWSSignatureWhitespaceStatePending;
+                }
+            } else {
+                if (*whitespaceState == AWSSignatureWhitespaceStatePending) {
+                    AWSSignatureSHA256StreamAppendByte(stream, ' ');
+                }
+                *whitespaceState = AWSSignatureWhitespaceStateNone;
+                AWSSignatureSHA256StreamAppendString(stream, lowercase ? [character lowercaseString] : character);
+            }
+            remainingRange = NSMakeRange(NSMaxRange(characterRange), NSMaxRange(remainingRange) - NSMaxRange(characterRange));
+        }
+    }
+}
+
+// Produces the same digest as hashing +[AWSSignatureV4Signer getCanonicalizedRequest:path:query:headers:contentSha256:].
+static void AWSSignatureV4HashCanonicalRequest(NSString *method,
+                                               NSString *path,
+                                               NSString *query,
+                                               NSDictionary *headers,
+                                               NSArray *sortedHeaderKeys,
+                                               NSString *signedHeaders,
+                                               NSString *contentSha256,
+                                               unsigned char digest[CC_SHA256_DIGEST_LENGTH]) {
+    AWSSignatureSHA256Stream stream;
+    CC_SHA256_Init(&stream.context);
+    stream.length = 0;
+
+    AWSSignatureSHA256StreamAppendString(&stream, method);
+    AWSSignatureSHA256StreamAppendByte(&stream, '\n');
+    AWSSignatureSHA256StreamAppendString(&stream, path);
+    AWSSignatureSHA256StreamAppendByte(&stream, '\n');
+    if ([query length] > 0) {
+        AWSSignatureSHA256StreamAppendString(&stream, [AWSSignatureV4Signer getCanonicalizedQueryString:query]);
+    }
+    AWSSignatureSHA256StreamAppendByte(&stream, '\n');
+
+    AWSSignatureWhitespaceState whitespaceState = AWSSignatureWhitespaceStateLeading;
+    for (NSString *header in sortedHeaderKeys) {
+        AWSSignatureSHA256StreamAppendHeaderString(&stream, header, YES, &whitespaceState);
+        AWSSignatureSHA256StreamAppendCharacter(&stream, ':', NO, &whitespaceState);
+        AWSSignatureSHA256StreamAppendHeaderString(&stream, [headers objectForKey:header], NO, &whitespaceState);
+        AWSSignatureSHA256StreamAppendCharacter(&stream, '\n', NO, &whitespaceState);
+    }
+    AWSSignatureSHA256StreamAppendByte(&stream, '\n');
+
+    AWSSignatureSHA256StreamAppendString(&stream, signedHeaders);
+    AWSSignatureSHA256StreamAppendByte(&stream, '\n');
+    AWSSignatureSHA256StreamAppendString(&stream, contentSha256);
+
+    AWSSignatureSHA256StreamFlush(&stream);
+    CC_SHA256_Final(digest, &stream.context);
+}
+
+static void AWSSignatureHmacUpdateWithString(CCHmacContext *context, NSString *string) {
+    unsigned char buffer[256];
+    NSRange remainingRange = NSMakeRange(0, [string length]);
+    while (remainingRange.length > 0) {
+        NSUInteger usedLength = 0;
+        [string getBytes:buffer
+               maxLength:sizeof(buffer)
+              usedLength:&usedLength
+                encoding:NSUTF8StringEncoding
+                 options:0
+                   range:remainingRange
+          remainingRange:&remainingRange];
+        if (usedLength == 0) {
+            break;
+        }
+        CCHmacUpdate(context, buffer, usedLength);
+    }
+}
+
+// Signs the string to sign without building it: "AWS4-HMAC-SHA256\n<dateTime>\n<scope>\n<hex of the canonical request digest>".
+static NSString *AWSSignatureV4SignatureString(NSData *kSigning,
+                                              NSString *dateTime,
+                                              NSString *scope,
+                                              const unsigned char canonicalRequestDigest[CC_SHA256_DIGEST_LENGTH]) {
+    char canonicalRequestHash[CC_SHA256_DIGEST_LENGTH * 2];
+    AWSSignatureHexEncodeBytes(canonicalRequestDigest, CC_SHA256_DIGEST_LENGTH, canonicalRequestHash);
+
+    CCHmacContext context;
+    CCHmacInit(&context, kCCHmacAlgSHA256, [kSigning bytes], [kSigning length]);
+    AWSSignatureHmacUpdateWithString(&context, AWSSignatureV4Algorithm);
+    CCHmacUpdate(&context, "\n", 1);
+    AWSSignatureHmacUpdateWithString(&context, dateTime);
+    CCHmacUpdate(&context, "\n", 1);
+    AWSSignatureHmacUpdateWithString(&context, scope);
+    CCHmacUpdate(&context, "\n", 1);
+    CCHmacUpdate(&context, canonicalRequestHash, sizeof(canonicalRequestHash));
+
+    unsigned char signature[CC_SHA256_DIGEST_LENGTH];
+    CCHmacFinal(&context, signature);
+
+    char signatureHex[CC_SHA256_DIGEST_LENGTH * 2];
+    AWSSignatureHexEncodeBytes(signature, CC_SHA256_DIGEST_LENGTH, signatureHex);
+
+    return [[NSString alloc] initWithBytes:signatureHex length:sizeof(signatureHex) encoding:NSASCIIStringEncoding];
+}
+
 @implementation AWSSignatureV4Signer
 
 + (instancetype)signerWithCredentialsProvider:(id<AWSCredentialsProvider>)credentialsProvider
@@ -219,7 +444,7 @@ NSString *const AWSSignatureV4Terminator = @"aws4_request";
         [urlRequest addValue:@"aws-chunked" forHTTPHeaderField:@"Content-Encoding"]; //add aws-chunked keyword for s3 chunk upload
         [urlRequest setValue:[NSString stringWithFormat:@"%lu", (unsigned long)contentLength] forHTTPHeaderField:@"x-amz-decoded-content-length"];
     } else {
-        contentSha256 = [AWSSignatureSignerUtility hexEncode:[[NSString alloc] initWithData:[AWSSignatureSignerUtility hash:[urlRequest HTTPBody]] encoding:NSASCIIStringEncoding]];
+        contentSha256 = [AWSSignatureSignerUtility hexEncodeData:[AWSSignatureSignerUtility hash:[urlRequest HTTPBody]]];
         //using Content-Length with value of '0' cause auth issue, remove it.
         if (contentLength == 0) {
             [urlRequest setValue:nil forHTTPHeaderField:@"Content-Length"];
@@ -243,36 +468,32 @@ NSString *const AWSSignatureV4Terminator = @"aws4_request";
         
     }
     
-    NSMutableDictionary *headers = [[urlRequest allHTTPHeaderFields] mutableCopy];
-
-    NSString *canonicalRequest = [AWSSignatureV4Signer getCanonicalizedRequest:httpMethod
-                                                                          path:path
-                                                                         query:query
-                                                                       headers:headers
-                                                                 contentSha256:contentSha256];
-    AWSLogDebug(@"Canonical request: [%@]", canonicalRequest);
-
-    NSString *stringToSign = [NSString stringWithFormat:@"%@\n%@\n%@\n%@",
-                              AWSSignatureV4Algorithm,
-                              [urlRequest valueForHTTPHeaderField:@"X-Amz-Date"],
-                              scope,
-                              [AWSSignatureSignerUtility hexEncode:[AWSSignatureSignerUtility hashString:canonicalRequest]]];
-    AWSLogDebug(@"AWS4 String to Sign: [%@]", stringToSign);
+    NSDictionary *headers = [urlRequest allHTTPHeaderFields];
+    NSArray *sortedHeaderKeys = [AWSSignatureV4Signer sortedHeaderKeys:headers];
+    NSString *signedHeaders = [AWSSignatureV4Signer signedHeadersStringWithSortedKeys:sortedHeaderKeys];
+    NSString *dateTime = [urlRequest valueForHTTPHeaderField:@"X-Amz-Date"];
+
+    unsigned char canonicalRequestDigest[CC_SHA256_DIGEST_LENGTH];
+    AWSSignatureV4HashCanonicalRequest(httpMethod, path, query, headers, sortedHeaderKeys, signedHeaders, contentSha256, canonicalRequestDigest);
+    [AWSSignatureV4Signer logCanonicalRequest:httpMethod
+                                         path:path
+                                        query:query
+                                      headers:headers
+                                contentSha256:contentSha256
+                                     dateTime:dateTime
+                                        scope:scope];
 
     NSData *kSigning  = [AWSSignatureV4Signer getV4DerivedKey:self.credentialsProvider.secretKey
                                                          date:dateStamp
                                                        region:self.endpoint.regionName
                                                       service:self.endpoint.serviceName];
 
-    NSData *signature = [AWSSignatureSignerUtility sha256HMacWithData:[stringToSign dataUsingEncoding:NSUTF8StringEncoding]
-                                                              withKey:kSigning];
-    NSString *signatureString = [AWSSignatureSignerUtility hexEncode:[[NSString alloc] initWithData:signature
-                                                                                           encoding:NSASCIIStringEncoding]];
+    NSString *signatureString = AWSSignatureV4SignatureString(kSigning, dateTime, scope, canonicalRequestDigest);
 
     NSString *authorization = [NSString stringWithFormat:@"%@ Credential=%@, SignedHeaders=%@, Signature=%@",
                                AWSSignatureV4Algorithm,
                                signingCredentials,
-                               [AWSSignatureV4Signer getSignedHeadersString:headers],
+                               signedHeaders,
                                signatureString];
 
     if (nil != stream) {
@@ -310,16 +531,15 @@ NSString *const AWSSignatureV4Terminator = @"aws4_request";
         query = [NSString stringWithFormat:@""];
     }
 
-    NSString *contentSha256 = [AWSSignatureSignerUtility hexEncode:[[NSString alloc] initWithData:[AWSSignatureSignerUtility hash:request.HTTPBody] encoding:NSASCIIStringEncoding]];
+    NSString *contentSha256 = [AWSSignatureSignerUtility hexEncodeData:[AWSSignatureSignerUtility hash:request.HTTPBody]];
 
-    NSString *canonicalRequest = [AWSSignatureV4Signer getCanonicalizedRequest:request.HTTPMethod
-                                                                          path:path
-                                                                         query:query
-                                                                       headers:request.allHTTPHeaderFields
-                                                                 contentSha256:contentSha256];
+    NSDictionary *headers = request.allHTTPHeaderFields;
+    NSArray *sortedHeaderKeys = [AWSSignatureV4Signer sortedHeaderKeys:headers];
+    NSString *signedHeaders = [AWSSignatureV4Signer signedHeadersStringWithSortedKeys:sortedHeaderKeys];
+    NSString *dateTime = [request valueForHTTPHeaderField:@"X-Amz-Date"];
 
-    AWSLogDebug(@"AWS4 Canonical Request: [%@]", canonicalRequest);
-    AWSLogDebug(@"payload %@",[[NSString alloc] initWithData:request.HTTPBody encoding:NSUTF8StringEncoding]);
+    unsigned char canonicalRequestDigest[CC_SHA256_DIGEST_LENGTH];
+    AWSSignatureV4HashCanonicalRequest(request.HTTPMethod, path, query, headers, sortedHeaderKeys, signedHeaders, contentSha256, canonicalRequestDigest);
 
     NSString *scope = [NSString stringWithFormat:@"%@/%@/%@/%@",
                        dateStamp,
@@ -329,35 +549,74 @@ NSString *const AWSSignatureV4Terminator = @"aws4_request";
     NSString *signingCredentials = [NSString stringWithFormat:@"%@/%@",
                                     self.credentialsProvider.accessKey,
                                     scope];
-    NSString *stringToSign = [NSString stringWithFormat:@"%@\n%@\n%@\n%@",
-                              AWSSignatureV4Algorithm,
-                              [request valueForHTTPHeaderField:@"X-Amz-Date"],
-                              scope,
-                              [AWSSignatureSignerUtility hexEncode:[AWSSignatureSignerUtility hashString:canonicalRequest]]];
-
-    AWSLogDebug(@"AWS4 String to Sign: [%@]", stringToSign);
+    [AWSSignatureV4Signer logCanonicalRequest:request.HTTPMethod
+                                         path:path
+                                        query:query
+                                      headers:headers
+                                contentSha256:contentSha256
+                                     dateTime:dateTime
+                                        scope:scope];
+    AWSLogDebug(@"payload %@",[[NSString alloc] initWithData:request.HTTPBody encoding:NSUTF8StringEncoding]);
 
     NSData *kSigning  = [AWSSignatureV4Signer getV4DerivedKey:self.credentialsProvider.secretKey
                                                          date:dateStamp
                                                        region:self.endpoint.regionName
                                                       service:self.endpoint.serviceName];
-    NSData *signature = [AWSSignatureSignerUtility sha256HMacWithData:[stringToSign dataUsingEncoding:NSUTF8StringEncoding]
-                                                              withKey:kSigning];
+    NSString *signatureString = AWSSignatureV4SignatureString(kSigning, dateTime, scope, canonicalRequestDigest);
 
-    NSString *credentialsAuthorizationHeader = [NSString stringWithFormat:@"Credential=%@", signingCredentials];
-    NSString *signedHeadersAuthorizationHeader = [NSString stringWithFormat:@"SignedHeaders=%@", [AWSSignatureV4Signer getSignedHeadersString:request.allHTTPHeaderFields]];
-    NSString *signatureAuthorizationHeader = [NSString stringWithFormat:@"Signature=%@", [AWSSignatureSignerUtility hexEncode:[[NSString alloc] initWithData:signature encoding:NSASCIIStringEncoding]]];
-
-    NSString *authorization = [NSString stringWithFormat:@"%@ %@, %@, %@",
+    NSString *authorization = [NSString stringWithFormat:@"%@ Credential=%@, SignedHeaders=%@, Signature=%@",
                                AWSSignatureV4Algorithm,
-                               credentialsAuthorizationHeader,
-                               signedHeadersAuthorizationHeader,
-                               signatureAuthorizationHeader];
+                               signingCredentials,
+                               signedHeaders,
+                               signatureString];
 
     return authorization;
 }
 
 
++ (void)logCanonicalRequest:(NSString *)method
+                       path:(NSString *)path
+                      query:(NSString *)query
+                    headers:(NSDictionary *)headers
+              contentSha256:(NSString *)contentSha256
+                   dateTime:(NSString *)dateTime
+                      scope:(NSString *)scope {
+    // The signers never build the canonical request and the string to sign, so they are only rendered when they are going to be logged.
+    if ([AWSLogger defaultLogger].logLevel < AWSLogLevelDebug) {
+        return;
+    }
+
+    NSString *canonicalRequest = [AWSSignatureV4Signer getCanonicalizedRequest:method
+                                                                          path:path
+                                                                         query:query
+                                                                       headers:headers
+                                                                 contentSha256:contentSha256];
+    AWSLogDebug(@"AWS4 Canonical Request: [%@]", canonicalRequest);
+
+    NSString *stringToSign = [NSString stringWithFormat:@"%@\n%@\n%@\n%@",
+                              AWSSignatureV4Algorithm,
+                              dateTime,
+                              scope,
+                              [AWSSignatureSignerUtility hexEncodeData:[AWSSignatureSignerUtility hash:[canonicalRequest dataUsingEncoding:NSUTF8StringEncoding]]]];
+    AWSLogDebug(@"AWS4 String to Sign: [%@]", stringToSign);
+}
+
++ (NSArray *)sortedHeaderKeys:(NSDictionary *)headers {
+    return [[headers allKeys] sortedArrayUsingSelector:@selector(caseInsensitiveCompare:)];
+}
+
++ (NSString *)signedHeadersStringWithSortedKeys:(NSArray *)sortedHeaderKeys {
+    NSMutableString *headerString = [NSMutableString new];
+    for (NSString *header in sortedHeaderKeys) {
+        if ( [headerString length] > 0) {
+            [headerString appendString:@";"];
+        }
+        [headerString appendString:[header lowercaseString]];
+    }
+
+    return headerString;
+}
+
 + (NSString *)getCanonicalizedRequest:(NSString *)method path:(NSString *)path query:(NSString *)query headers:(NSDictionary *)headers contentSha256:(NSString *)contentSha256 {
     NSMutableString *canonicalRequest = [NSMutableString new];
     [canonicalRequest appendString:method];
@@ -428,22 +687,67 @@ NSString *const AWSSignatureV4Terminator = @"aws4_request";
 }
 
 + (NSString *)getSignedHeadersString:(NSDictionary *)headers {
-    NSMutableArray *sortedHeaders = [[NSMutableArray alloc] initWithArray:[headers allKeys]];
+    return [self signedHeadersStringWithSortedKeys:[self sortedHeaderKeys:headers]];
+}
 
-    [sortedHeaders sortUsingSelector:@selector(caseInsensitiveCompare:)];
++ (NSMutableDictionary *)derivedKeys {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _derivedKeys = [NSMutableDictionary new];
+    });
+    return _derivedKeys;
+}
 
-    NSMutableString *headerString = [NSMutableString new];
-    for (NSString *header in sortedHeaders) {
-        if ( [headerString length] > 0) {
-            [headerString appendString:@";"];
++ (NSData *)getV4DerivedKey:(NSString *)secret date:(NSString *)dateStamp region:(NSString *)regionName service:(NSString *)serviceName {
+    // The derived key only changes with the secret, the day, the region and the service, so it is cached by those.
+    // The secret itself is not kept in the cache, only its SHA-256 fingerprint.
+    NSData *secretFingerprint = [AWSSignatureSignerUtility hash:[secret dataUsingEncoding:NSUTF8StringEncoding]];
+    NSString *scope = [NSString stringWithFormat:@"%@/%@/%@", dateStamp, regionName, serviceName];
+
+    NSMutableDictionary *derivedKeys = [self derivedKeys];
+    @synchronized(derivedKeys) {
+        NSData *kSigning = derivedKeys[secretFingerprint][scope];
+        if (kSigning) {
+            return kSigning;
         }
-        [headerString appendString:[header lowercaseString]];
     }
 
-    return headerString;
+    NSData *kSigning = [self deriveV4Key:secret date:dateStamp region:regionName service:serviceName];
+
+    @synchronized(derivedKeys) {
+        NSUInteger count = 0;
+        for (NSDictionary *keysOfSecret in [derivedKeys allValues]) {
+            count += [keysOfSecret count];
+        }
+        if (count >= AWSSignatureV4DerivedKeyCacheLimit) {
+            // Old dates and secrets are not needed anymore; starting over is cheaper than tracking their age.
+            [derivedKeys removeAllObjects];
+        }
+
+        NSMutableDictionary *keysOfSecret = derivedKeys[secretFingerprint];
+        if (!keysOfSecret) {
+            keysOfSecret = [NSMutableDictionary new];
+            derivedKeys[secretFingerprint] = keysOfSecret;
+        }
+        keysOfSecret[scope] = kSigning;
+    }
+
+    return kSigning;
 }
 
-+ (NSData *)getV4DerivedKey:(NSString *)secret date:(NSString *)dateStamp region:(NSString *)regionName service:(NSString *)serviceName {
++ (void)removeDerivedKeysForSecret:(NSString *)secret {
+    if (!secret) {
+        return;
+    }
+
+    NSData *secretFingerprint = [AWSSignatureSignerUtility hash:[secret dataUsingEncoding:NSUTF8StringEncoding]];
+    NSMutableDictionary *derivedKeys = [self derivedKeys];
+    @synchronized(derivedKeys) {
+        [derivedKeys removeObjectForKey:secretFingerprint];
+    }
+}
+
++ (NSData *)deriveV4Key:(NSString *)secret date:(NSString *)dateStamp region:(NSString *)regionName service:(NSString *)serviceName {
     // AWS4 uses a series of derived keys, formed by hashing different pieces of data
     NSString *kSecret = [NSString stringWithFormat:@"%@%@", AWSSigV4Marker, secret];
     NSData *kDate = [AWSSignatureSignerUtility sha256HMacWithData:[dateStamp dataUsingEncoding:NSUTF8StringEncoding]
@@ -455,7 +759,6 @@ NSString *const AWSSignatureV4Terminator = @"aws4_request";
     NSData *kSigning = [AWSSignatureSignerUtility sha256HMacWithData:[AWSSignatureV4Terminator dataUsingEncoding:NSUTF8StringEncoding]
                                                              withKey:kService];
 
-    //TODO: cache this derived key?
     return kSigning;
 }
 
@@ -565,16 +868,31 @@ NSString *const AWSSignatureV4Terminator = @"aws4_request";
 #pragma mark - S3ChunkedEncodingInputStream
 
 NSUInteger defaultChunkSize = 32 * 1024 - 91;
-NSString *const emptyStringSha256 = @"e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
 
-@interface AWSS3ChunkedEncodingInputStream()
+// The part of the chunk string to sign between the prior signature and the chunk hash: "\n<sha256 of the empty string>\n".
+static const char AWSS3ChunkedEncodingEmptyStringSha256Line[] = "\ne3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855\n";
+// Separates the chunk size from the chunk signature in every chunk header.
+static const char AWSS3ChunkedEncodingSignatureMarker[] = ";chunk-signature=";
+static const NSUInteger AWSS3ChunkedEncodingSignatureLength = CC_SHA256_DIGEST_LENGTH * 2;
+
+@interface AWSS3ChunkedEncodingInputStream() {
+    // Buffer the original stream is read into. It is reused for every chunk.
+    uint8_t *_dataBuffer;
+    NSUInteger _dataBufferCapacity;
+
+    // HMAC context already keyed and fed with "AWS4-HMAC-SHA256-PAYLOAD\n<date>\n<scope>\n", which is the same for every chunk.
+    CCHmacContext _stringToSignPrefixContext;
+
+    // Hex signature of previous chunk. It's initialized as that of headers.
+    char _priorSignature[CC_SHA256_DIGEST_LENGTH * 2];
+}
 
 @property (nonatomic, weak) id<NSStreamDelegate> delegate;
 
 // original input stream
 @property (nonatomic, strong) NSInputStream *stream;
 
-// buffer for chunked data plus header
+// buffer for chunked data plus header. It is reused for every chunk.
 @property (nonatomic, strong) NSMutableData *chunkData;
 
 // Mark the location of chunkData to be read
@@ -590,9 +908,6 @@ NSString *const emptyStringSha256 = @"e3b0c44298fc1c149afbf4c8996fb92427ae41e464
 // Keypath/Scope
 @property (nonatomic, strong) NSString *scope;
 
-// Signature of previous chunk. It's initialized as that of headers.
-@property (nonatomic, strong) NSString *priorSha256;
-
 // SigV4 signing key
 @property (nonatomic, strong) NSData *kSigning;
 
@@ -613,7 +928,24 @@ NSString *const emptyStringSha256 = @"e3b0c44298fc1c149afbf4c8996fb92427ae41e464
         _date = [date copy];
         _scope = [scope copy];
         _kSigning = [kSigning copy];
-        _priorSha256 = [headerSignature copy];
+
+        memset(_priorSignature, '0', sizeof(_priorSignature));
+        [headerSignature getBytes:_priorSignature
+                        maxLength:sizeof(_priorSignature)
+                       usedLength:NULL
+                         encoding:NSASCIIStringEncoding
+                          options:0
+                            range:NSMakeRange(0, [headerSignature length])
+                   remainingRange:NULL];
+
+        // The date and the scope do not change within a stream, so the start of the string to sign is only signed once.
+        NSString *stringToSignPrefix = [NSString stringWithFormat:@"%@\n%@\n%@\n",
+                                        @"AWS4-HMAC-SHA256-PAYLOAD",
+                                        [_date aws_stringValue:AWSDateISO8601DateFormat2],
+                                        _scope];
+        NSData *stringToSignPrefixData = [stringToSignPrefix dataUsingEncoding:NSUTF8StringEncoding];
+        CCHmacInit(&_stringToSignPrefixContext, kCCHmacAlgSHA256, [_kSigning bytes], [_kSigning length]);
+        CCHmacUpdate(&_stringToSignPrefixContext, [stringToSignPrefixData bytes], [stringToSignPrefixData length]);
 
         // Chunk size plus signature header
         NSUInteger chunkSize = defaultChunkSize + [AWSS3ChunkedEncodingInputStream oneChunkedDataSize:defaultChunkSize];
@@ -623,6 +955,10 @@ NSString *const emptyStringSha256 = @"e3b0c44298fc1c149afbf4c8996fb92427ae41e464
     return self;
 }
 
+- (void)dealloc {
+    free(_dataBuffer);
+}
+
 - (void)stream:(NSStream *)aStream handleEvent:(NSStreamEvent)eventCode {
     if ((eventCode & (1 << 4))) {
         // toggle the NSStreamEventEndEncountered bit.
@@ -640,54 +976,70 @@ NSString *const emptyStringSha256 = @"e3b0c44298fc1c149afbf4c8996fb92427ae41e464
         return NO;
     }
 
-    // clear current chunkData for next chunk
-    [self.chunkData setLength:0];
+    // the buffer only grows when the caller starts reading in larger pieces.
+    NSUInteger chunkSize = defaultChunkSize;
+    if (_dataBufferCapacity < chunkSize) {
+        _dataBuffer = reallocf(_dataBuffer, chunkSize);
+        _dataBufferCapacity = _dataBuffer ? chunkSize : 0;
+    }
 
-    uint8_t *chunkBuffer = calloc(defaultChunkSize, sizeof(uint8_t));
-    NSInteger read = [self.stream read:chunkBuffer maxLength:defaultChunkSize];
+    NSInteger read = _dataBuffer ? [self.stream read:_dataBuffer maxLength:chunkSize] : -1;
 
     // mark end of stream if no data is read
     self.endOfStream = (read <= 0);
 
-    NSData *data = [NSData dataWithBytesNoCopy:chunkBuffer length:read];
-    [self.chunkData appendData:[self getSignedChunk:data]];
+    [self signChunk:_dataBuffer length:read > 0 ? read : 0];
 
     AWSLogDebug(@"stream read: %ld, chunk size: %lu", (long)read, (unsigned long)[self.chunkData length]);
 
     return YES;
 }
 
-// Signs data
-- (NSData *)getSignedChunk:(NSData *)data {
-    NSString *chunkSha256 = [self dataToHexString:[AWSSignatureSignerUtility hash:data]];
-    NSString *stringToSign = [NSString stringWithFormat:
-                              @"%@\n%@\n%@\n%@\n%@\n%@",
-                              @"AWS4-HMAC-SHA256-PAYLOAD",
-                              [self.date aws_stringValue:AWSDateISO8601DateFormat2],
-                              self.scope,
-                              self.priorSha256,
-                              emptyStringSha256,
-                              chunkSha256];
-    AWSLogDebug(@"AWS4 String to Sign: [%@]", stringToSign);
-
-    NSData *signature = [AWSSignatureSignerUtility sha256HMacWithData:[stringToSign dataUsingEncoding:NSUTF8StringEncoding]
-                                                              withKey:self.kSigning];
-    self.priorSha256 = [self dataToHexString:signature];
-    NSString *chunkedHeader = [NSString stringWithFormat:@"%06lx;chunk-signature=%@\r\n", (unsigned long)[data length], self.priorSha256];
-    AWSLogDebug(@"AWS4 Chunked Header: [%@]", chunkedHeader);
+// Signs data and writes the signed chunk into chunkData
+- (void)signChunk:(const uint8_t *)data length:(NSUInteger)length {
+    unsigned char chunkDigest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(data, (CC_LONG)length, chunkDigest);
+    char chunkSha256[CC_SHA256_DIGEST_LENGTH * 2];
+    AWSSignatureHexEncodeBytes(chunkDigest, CC_SHA256_DIGEST_LENGTH, chunkSha256);
+
+    // "AWS4-HMAC-SHA256-PAYLOAD\n<date>\n<scope>\n<prior signature>\n<sha256 of the empty string>\n<chunk sha256>"
+    CCHmacContext context = _stringToSignPrefixContext;
+    CCHmacUpdate(&context, _priorSignature, sizeof(_priorSignature));
+    CCHmacUpdate(&context, AWSS3ChunkedEncodingEmptyStringSha256Line, sizeof(AWSS3ChunkedEncodingEmptyStringSha256Line) - 1);
+    CCHmacUpdate(&context, chunkSha256, sizeof(chunkSha256));
+
+    unsigned char signature[CC_SHA256_DIGEST_LENGTH];
+    CCHmacFinal(&context, signature);
+    AWSSignatureHexEncodeBytes(signature, CC_SHA256_DIGEST_LENGTH, _priorSignature);
+
+    // <chunk size in hex>;chunk-signature=<signature>\r\n<data>\r\n
+    char chunkSizeHex[2 * sizeof(unsigned long) + 1];
+    int chunkSizeHexLength = snprintf(chunkSizeHex, sizeof(chunkSizeHex), "%06lx", (unsigned long)length);
+    NSUInteger markerLength = sizeof(AWSS3ChunkedEncodingSignatureMarker) - 1;
+
+    [self.chunkData setLength:[AWSS3ChunkedEncodingInputStream oneChunkedDataSize:length]];
+    uint8_t *chunk = [self.chunkData mutableBytes];
+    memcpy(chunk, chunkSizeHex, chunkSizeHexLength);
+    chunk += chunkSizeHexLength;
+    memcpy(chunk, AWSS3ChunkedEncodingSignatureMarker, markerLength);
+    chunk += markerLength;
+    memcpy(chunk, _priorSignature, sizeof(_priorSignature));
+    chunk += sizeof(_priorSignature);
+    memcpy(chunk, "\r\n", 2);
+    chunk += 2;
+    if (length > 0) {
+        memcpy(chunk, data, length);
+        chunk += length;
+    }
+    memcpy(chunk, "\r\n", 2);
 
-    NSMutableData *signedChunk = [NSMutableData data];
-    [signedChunk appendData:[chunkedHeader dataUsingEncoding:NSUTF8StringEncoding]];
-    [signedChunk appendData:data];
-    [signedChunk appendData:[@"\r\n" dataUsingEncoding:NSUTF8StringEncoding]];
+    if ([AWSLogger defaultLogger].logLevel >= AWSLogLevelDebug) {
+        AWSLogDebug(@"AWS4 Chunked Header: [%@]", [[NSString alloc] initWithBytes:[self.chunkData bytes]
+                                                                           length:chunkSizeHexLength + markerLength + sizeof(_priorSignature)
+                                                                         encoding:NSASCIIStringEncoding]);
+    }
 
     self.totalLengthOfChunkSignatureSent += [AWSS3ChunkedEncodingInputStream oneChunkedDataSize:0];
-    return signedChunk;
-}
-
-- (NSString *)dataToHexString:(NSData *) data {
-    return [AWSSignatureSignerUtility hexEncode:[[NSString alloc] initWithData:data
-                                                                      encoding:NSASCIIStringEncoding]];
 }
 
 #pragma mark NSInputStream methods
@@ -788,7 +1140,12 @@ NSString *const emptyStringSha256 = @"e3b0c44298fc1c149afbf4c8996fb92427ae41e464
  * <data>\r\n
  **/
 + (NSUInteger)oneChunkedDataSize:(NSUInteger)dataLength {
-    return [[NSString stringWithFormat:@"%06lx;chunk-signature=%@\r\n",  (unsigned long)dataLength, emptyStringSha256] length] + dataLength + [@"\r\n" length];
+    // the chunk size takes at least six hex digits
+    NSUInteger chunkSizeHexLength = 6;
+    for (NSUInteger remaining = dataLength >> 24; remaining > 0; remaining >>= 4) {
+        chunkSizeHexLength++;
+    }
+    return chunkSizeHexLength + (sizeof(AWSS3ChunkedEncodingSignatureMarker) - 1) + AWSS3ChunkedEncodingSignatureLength + 2 + dataLength + 2;
 }
 
 + (NSUInteger)computeContentLengthForChunkedData:(NSUInteger)dataLength {
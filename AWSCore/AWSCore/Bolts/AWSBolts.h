@@ -8,6 +8,8 @@
  *
  */
 
+#import "AWSCancellationToken.h"
+#import "AWSCancellationTokenSource.h"
 #import "AWSExecutor.h"
 #import "AWSTask.h"
 #import "AWSTaskCompletionSource.h"
@@ -0,0 +1,210 @@
+/*
+ *  Copyright (c) 2014, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import "AWSCancellationToken.h"
+
+@interface AWSCancellationTokenRegistration ()
+
+@property (nonatomic, weak) AWSCancellationToken *token;
+@property (nonatomic, copy) AWSCancellationBlock cancellationObserverBlock;
+@property (nonatomic, strong) NSObject *lock;
+@property (nonatomic, assign) BOOL disposed;
+
++ (instancetype)registrationWithToken:(AWSCancellationToken *)token delegate:(AWSCancellationBlock)delegate;
+
+- (void)notifyDelegate;
+
+@end
+
+@interface AWSCancellationToken ()
+
+@property (nonatomic, assign, readwrite, getter=isCancellationRequested) BOOL cancellationRequested;
+@property (nonatomic, strong) NSMutableArray *registrations;
+@property (nonatomic, strong) NSObject *lock;
+@property (nonatomic, assign) BOOL disposed;
+@property (nonatomic, assign) NSUInteger delayedCancellationGeneration;
+
+- (void)unregisterRegistration:(AWSCancellationTokenRegistration *)registration;
+
+@end
+
+@implementation AWSCancellationTokenRegistration
+
++ (instancetype)registrationWithToken:(AWSCancellationToken *)token delegate:(AWSCancellationBlock)delegate {
+    AWSCancellationTokenRegistration *registration = [AWSCancellationTokenRegistration new];
+    registration.token = token;
+    registration.cancellationObserverBlock = delegate;
+    return registration;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _lock = [NSObject new];
+    }
+    return self;
+}
+
+- (void)dispose {
+    @synchronized (self.lock) {
+        if (self.disposed) {
+            return;
+        }
+        self.disposed = YES;
+    }
+
+    AWSCancellationToken *token = self.token;
+    if (token != nil) {
+        [token unregisterRegistration:self];
+        self.token = nil;
+    }
+    self.cancellationObserverBlock = nil;
+}
+
+- (void)notifyDelegate {
+    AWSCancellationBlock block = nil;
+    @synchronized (self.lock) {
+        if (self.disposed) {
+            return;
+        }
+        block = self.cancellationObserverBlock;
+    }
+    if (block) {
+        block();
+    }
+}
+
+@end
+
+@implementation AWSCancellationToken
+
+#pragma mark - Initializer
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _registrations = [NSMutableArray array];
+        _lock = [NSObject new];
+    }
+    return self;
+}
+
+#pragma mark - Custom Setters/Getters
+
+- (BOOL)isCancellationRequested {
+    @synchronized (self.lock) {
+        [self throwIfDisposed];
+        return _cancellationRequested;
+    }
+}
+
+- (void)cancel {
+    NSArray *registrations;
+    @synchronized (self.lock) {
+        [self throwIfDisposed];
+        if (_cancellationRequested) {
+            return;
+        }
+        // Invalidates any pending delayed cancellation.
+        self.delayedCancellationGeneration++;
+        _cancellationRequested = YES;
+        registrations = [self.registrations copy];
+    }
+
+    // The observers run outside the lock so that they can inspect or register with this token.
+    for (AWSCancellationTokenRegistration *registration in registrations) {
+        [registration notifyDelegate];
+    }
+}
+
+- (AWSCancellationTokenRegistration *)registerCancellationObserverWithBlock:(AWSCancellationBlock)block {
+    @synchronized (self.lock) {
+        if (!_cancellationRequested) {
+            AWSCancellationTokenRegistration *registration = [AWSCancellationTokenRegistration registrationWithToken:self delegate:[block copy]];
+            [self.registrations addObject:registration];
+            return registration;
+        }
+    }
+    block();
+    return nil;
+}
+
+- (void)unregisterRegistration:(AWSCancellationTokenRegistration *)registration {
+    @synchronized (self.lock) {
+        [self.registrations removeObject:registration];
+    }
+}
+
+- (void)cancelAfterDelay:(int)millis {
+    [self throwIfDisposed];
+    if (millis < -1) {
+        [NSException raise:NSInvalidArgumentException format:@"Delay must be >= -1"];
+    }
+
+    if (millis == 0) {
+        [self cancel];
+        return;
+    }
+
+    NSUInteger generation;
+    @synchronized (self.lock) {
+        // A new delay, or -1, replaces the one scheduled before.
+        generation = ++self.delayedCancellationGeneration;
+    }
+    if (millis == -1) {
+        return;
+    }
+
+    __weak AWSCancellationToken *weakSelf = self;
+    dispatch_time_t popTime = dispatch_time(DISPATCH_TIME_NOW, (int64_t)(millis * NSEC_PER_MSEC));
+    dispatch_after(popTime, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        AWSCancellationToken *strongSelf = weakSelf;
+        BOOL current;
+        @synchronized (strongSelf.lock) {
+            current = !strongSelf.disposed && strongSelf.delayedCancellationGeneration == generation;
+        }
+        if (current) {
+            [strongSelf cancel];
+        }
+    });
+}
+
+- (void)dispose {
+    NSArray *registrations;
+    @synchronized (self.lock) {
+        if (self.disposed) {
+            return;
+        }
+        registrations = [self.registrations copy];
+        [self.registrations removeAllObjects];
+        self.delayedCancellationGeneration++;
+        self.disposed = YES;
+    }
+
+    for (AWSCancellationTokenRegistration *registration in registrations) {
+        registration.token = nil;
+        [registration dispose];
+    }
+}
+
+- (void)throwIfDisposed {
+    if (self.disposed) {
+        [NSException raise:NSInternalInconsistencyException format:@"Object already disposed"];
+    }
+}
+
+#pragma mark - NSObject
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p; cancellationRequested = %@>",
+            NSStringFromClass([self class]),
+            self,
+            self.cancellationRequested ? @"YES" : @"NO"];
+}
+
+@end
@@ -0,0 +1,56 @@
+/*
+ *  Copyright (c) 2014, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import "AWSCancellationTokenSource.h"
+
+#import "AWSCancellationToken.h"
+
+@interface AWSCancellationToken (AWSCancellationTokenSource)
+
+- (void)cancel;
+- (void)cancelAfterDelay:(int)millis;
+- (void)dispose;
+
+@end
+
+@implementation AWSCancellationTokenSource
+
+#pragma mark - Initializer
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _token = [AWSCancellationToken new];
+    }
+    return self;
+}
+
++ (instancetype)cancellationTokenSource {
+    return [AWSCancellationTokenSource new];
+}
+
+#pragma mark - Custom Setters/Getters
+
+- (BOOL)isCancellationRequested {
+    return _token.isCancellationRequested;
+}
+
+- (void)cancel {
+    [_token cancel];
+}
+
+- (void)cancelAfterDelay:(int)millis {
+    [_token cancelAfterDelay:millis];
+}
+
+- (void)dispose {
+    [_token dispose];
+}
+
+@end
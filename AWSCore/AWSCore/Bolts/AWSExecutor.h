@@ -31,6 +31,18 @@
  */
 + (instancetype)mainThreadExecutor;
 
+/*!
+ Returns a shared executor for work the user is waiting on. It runs up to one continuation per active
+ processor at once, and at least two, at `NSQualityOfServiceUserInitiated`.
+ */
++ (instancetype)userInitiatedExecutor;
+
+/*!
+ Returns a shared executor for deferrable work such as uploading analytics or Kinesis records. It runs at
+ most two continuations at once, at `NSQualityOfServiceBackground`, so a burst of it cannot starve the app.
+ */
++ (instancetype)backgroundExecutor;
+
 /*!
  Returns a new executor that uses the given block to execute continuations.
  @param block The block to use.
@@ -49,6 +61,14 @@
  */
 + (instancetype)executorWithOperationQueue:(NSOperationQueue *)queue;
 
+/*!
+ Returns a new executor that runs at most the given number of continuations at once, at the given quality of service.
+ @param maxConcurrentOperationCount The maximum number of continuations running at the same time.
+ @param qualityOfService The quality of service of the threads running the continuations.
+ */
++ (instancetype)executorWithMaxConcurrentOperationCount:(NSInteger)maxConcurrentOperationCount
+                                       qualityOfService:(NSQualityOfService)qualityOfService;
+
 /*!
  Runs the given block using this executor's particular strategy.
  @param block The block to execute.
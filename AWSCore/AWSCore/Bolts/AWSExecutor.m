@@ -10,6 +10,61 @@
 
 #import "AWSExecutor.h"
 
+#import <pthread.h>
+
+static const int BFTaskDefaultExecutorMaxDepth = 20;
+
+// The depth of continuations running inline on the current thread. The value of the key is the depth itself,
+// so reading and updating it allocates nothing. (`__thread` is not available for the iOS 8 deployment target.)
+static pthread_key_t BFTaskDepthKey;
+static pthread_once_t BFTaskDepthKeyOnce = PTHREAD_ONCE_INIT;
+
+static void BFTaskCreateDepthKey(void) {
+    pthread_key_create(&BFTaskDepthKey, NULL);
+}
+
+static inline intptr_t BFTaskGetDepth(void) {
+    pthread_once(&BFTaskDepthKeyOnce, BFTaskCreateDepthKey);
+    return (intptr_t)pthread_getspecific(BFTaskDepthKey);
+}
+
+static inline void BFTaskSetDepth(intptr_t depth) {
+    pthread_setspecific(BFTaskDepthKey, (const void *)depth);
+}
+
+static AWSExecutor *AWSDefaultExecutor = nil;
+static AWSExecutor *AWSImmediateExecutor = nil;
+static AWSExecutor *AWSMainThreadExecutor = nil;
+
+/*!
+ Used by `AWSTask` to run a continuation of a completed task without wrapping it in blocks. Returns `YES` when
+ the executor would run the continuation on the current thread right away; the caller then runs it and calls
+ `AWSExecutorExitInlineExecution()`.
+ */
+BOOL AWSExecutorEnterInlineExecution(AWSExecutor *executor) {
+    if (!executor) {
+        return NO;
+    }
+    if (executor == AWSDefaultExecutor) {
+        intptr_t depth = BFTaskGetDepth();
+        if (depth > BFTaskDefaultExecutorMaxDepth) {
+            return NO;
+        }
+        BFTaskSetDepth(depth + 1);
+        return YES;
+    }
+    if (executor == AWSImmediateExecutor
+        || (executor == AWSMainThreadExecutor && [NSThread isMainThread])) {
+        BFTaskSetDepth(BFTaskGetDepth() + 1);
+        return YES;
+    }
+    return NO;
+}
+
+void AWSExecutorExitInlineExecution(void) {
+    BFTaskSetDepth(BFTaskGetDepth() - 1);
+}
+
 @interface AWSExecutor ()
 
 @property (nonatomic, copy) void(^block)(void(^block)());
@@ -21,53 +76,43 @@
 #pragma mark - Executor methods
 
 + (instancetype)defaultExecutor {
-    static AWSExecutor *defaultExecutor = NULL;
     static dispatch_once_t onceToken;
     dispatch_once(&onceToken, ^{
-        defaultExecutor = [self executorWithBlock:^void(void(^block)()) {
-            static const NSString *BFTaskDepthKey = @"BFTaskDepth";
-            static const int BFTaskDefaultExecutorMaxDepth = 20;
-
+        AWSDefaultExecutor = [self executorWithBlock:^void(void(^block)()) {
             // We prefer to run everything possible immediately, so that there is callstack information
             // when debugging. However, we don't want the stack to get too deep, so if the number of
             // recursive calls to this method exceeds a certain depth, we dispatch to another GCD queue.
-            NSMutableDictionary *threadLocal = [[NSThread currentThread] threadDictionary];
-            NSNumber *depth = threadLocal[BFTaskDepthKey];
-            if (!depth) {
-                depth = @0;
-            }
-            if (depth.intValue > BFTaskDefaultExecutorMaxDepth) {
-                dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), block);
+            // The spilled continuation keeps the quality of service of the thread it came from.
+            intptr_t depth = BFTaskGetDepth();
+            if (depth > BFTaskDefaultExecutorMaxDepth) {
+                dispatch_async(dispatch_get_global_queue(qos_class_self(), 0), block);
             } else {
-                NSNumber *previousDepth = depth;
-                threadLocal[BFTaskDepthKey] = @(previousDepth.intValue + 1);
+                BFTaskSetDepth(depth + 1);
                 @try {
                     block();
                 } @finally {
-                    threadLocal[BFTaskDepthKey] = previousDepth;
+                    BFTaskSetDepth(depth);
                 }
             }
         }];
     });
-    return defaultExecutor;
+    return AWSDefaultExecutor;
 }
 
 + (instancetype)immediateExecutor {
-    static AWSExecutor *immediateExecutor = NULL;
     static dispatch_once_t onceToken;
     dispatch_once(&onceToken, ^{
-        immediateExecutor = [self executorWithBlock:^void(void(^block)()) {
+        AWSImmediateExecutor = [self executorWithBlock:^void(void(^block)()) {
             block();
         }];
     });
-    return immediateExecutor;
+    return AWSImmediateExecutor;
 }
 
 + (instancetype)mainThreadExecutor {
-    static AWSExecutor *mainThreadExecutor = NULL;
     static dispatch_once_t onceToken;
     dispatch_once(&onceToken, ^{
-        mainThreadExecutor = [self executorWithBlock:^void(void(^block)()) {
+        AWSMainThreadExecutor = [self executorWithBlock:^void(void(^block)()) {
             if (![NSThread isMainThread]) {
                 dispatch_async(dispatch_get_main_queue(), block);
             } else {
@@ -75,7 +120,27 @@
             }
         }];
     });
-    return mainThreadExecutor;
+    return AWSMainThreadExecutor;
+}
+
++ (instancetype)userInitiatedExecutor {
+    static AWSExecutor *userInitiatedExecutor = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        userInitiatedExecutor = [self executorWithMaxConcurrentOperationCount:MAX([[NSProcessInfo processInfo] activeProcessorCount], 2)
+                                                             qualityOfService:NSQualityOfServiceUserInitiated];
+    });
+    return userInitiatedExecutor;
+}
+
++ (instancetype)backgroundExecutor {
+    static AWSExecutor *backgroundExecutor = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        backgroundExecutor = [self executorWithMaxConcurrentOperationCount:2
+                                                          qualityOfService:NSQualityOfServiceBackground];
+    });
+    return backgroundExecutor;
 }
 
 + (instancetype)executorWithBlock:(void(^)(void(^block)()))block {
@@ -94,6 +159,14 @@
     }];
 }
 
++ (instancetype)executorWithMaxConcurrentOperationCount:(NSInteger)maxConcurrentOperationCount
+                                       qualityOfService:(NSQualityOfService)qualityOfService {
+    NSOperationQueue *queue = [NSOperationQueue new];
+    queue.maxConcurrentOperationCount = maxConcurrentOperationCount;
+    queue.qualityOfService = qualityOfService;
+    return [self executorWithOperationQueue:queue];
+}
+
 #pragma mark - Initializer
 
 - (instancetype)initWithBlock:(void(^)(void(^block)()))block {
@@ -20,6 +20,7 @@ extern NSString *const AWSTaskErrorDomain;
  */
 extern NSString *const AWSTaskMultipleExceptionsException;
 
+@class AWSCancellationToken;
 @class AWSExecutor;
 @class AWSTask;
 
@@ -28,6 +29,19 @@ extern NSString *const AWSTaskMultipleExceptionsException;
  */
 typedef id(^AWSContinuationBlock)(AWSTask *task);
 
+/*!
+ A block that starts the task for one object of
+ <AWSTask taskForCompletionOfTasksWithObjects:maxConcurrentTaskCount:cancellationToken:progressBlock:block:>.
+ The block should pass `cancellationToken` on to the work it starts, so that the work stops
+ when a sibling task fails or the caller cancels.
+ */
+typedef AWSTask *(^AWSTaskObjectBlock)(id object, NSUInteger index, AWSCancellationToken *cancellationToken);
+
+/*!
+ A block that is told how many tasks out of the total have completed successfully.
+ */
+typedef void(^AWSTaskProgressBlock)(NSUInteger completedCount, NSUInteger totalCount);
+
 /*!
  The consumer view of a Task. A AWSTask has methods to
  inspect the state of the task, and to add continuations to
@@ -73,6 +87,34 @@ typedef id(^AWSContinuationBlock)(AWSTask *task);
  */
 + (instancetype)taskForCompletionOfAllTasksWithResults:(NSArray *)tasks;
 
+/*!
+ Returns a task that will be completed once any of the input tasks completes successfully,
+ with the result of that task. If none of them completes successfully, the returned task fails
+ the way <AWSTask taskForCompletionOfAllTasks:> would, or is cancelled if all of them were cancelled.
+ @param tasks An `NSArray` of the tasks to use as an input.
+ */
++ (instancetype)taskForCompletionOfAnyTask:(NSArray *)tasks;
+
+/*!
+ Starts a task for each object with the given block, running at most `maxConcurrentTaskCount`
+ of them at once, and returns a task that will be completed once they have all completed.
+ If they all complete successfully, the result is an `NSArray` of their results in the order of
+ `objects`, with `NSNull` standing in for nil results.
+ The first task that fails or is cancelled stops the others: no more tasks are started, and the
+ cancellation token given to the running ones is cancelled. The returned task then completes with
+ that failure, or is cancelled, once the running tasks have completed.
+ @param objects An `NSArray` of the objects to start tasks for.
+ @param maxConcurrentTaskCount The maximum number of tasks running at once. `0` means no limit.
+ @param cancellationToken A token that stops the tasks when cancelled. May be nil.
+ @param progressBlock A block that is called each time a task completes successfully. May be nil.
+ @param block The block starting the task for an object.
+ */
++ (instancetype)taskForCompletionOfTasksWithObjects:(NSArray *)objects
+                             maxConcurrentTaskCount:(NSUInteger)maxConcurrentTaskCount
+                                  cancellationToken:(AWSCancellationToken *)cancellationToken
+                                      progressBlock:(AWSTaskProgressBlock)progressBlock
+                                              block:(AWSTaskObjectBlock)block;
+
 /*!
  Returns a task that will be completed a certain amount of time in the future.
  @param millis The approximate number of milliseconds to wait before the
@@ -80,6 +122,16 @@ typedef id(^AWSContinuationBlock)(AWSTask *task);
  */
 + (instancetype)taskWithDelay:(int)millis;
 
+/*!
+ Returns a task that will be completed a certain amount of time in the future,
+ or cancelled as soon as the given token is cancelled.
+ @param millis The approximate number of milliseconds to wait before the
+ task will be finished (with result == nil).
+ @param token The cancellation token.
+ */
++ (instancetype)taskWithDelay:(int)millis
+            cancellationToken:(AWSCancellationToken *)token;
+
 /*!
  Returns a task that will be completed after the given block completes with
  the specified executor.
@@ -139,6 +191,19 @@ typedef id(^AWSContinuationBlock)(AWSTask *task);
  */
 - (instancetype)continueWithBlock:(AWSContinuationBlock)block;
 
+/*!
+ Enqueues the given block to be run once this task is complete.
+ This method uses a default execution strategy.
+ @param block The block to be run once this task is complete.
+ @param cancellationToken The cancellation token. If it is cancelled by the time
+ this task completes, the block is not run and the returned task is cancelled.
+ @returns A task that will be completed after block has run.
+ If block returns a AWSTask, then the task returned from
+ this method will not be completed until that task is completed.
+ */
+- (instancetype)continueWithBlock:(AWSContinuationBlock)block
+                cancellationToken:(AWSCancellationToken *)cancellationToken;
+
 /*!
  Enqueues the given block to be run once this task is complete.
  @param executor A BFExecutor responsible for determining how the
@@ -151,6 +216,21 @@ typedef id(^AWSContinuationBlock)(AWSTask *task);
 - (instancetype)continueWithExecutor:(AWSExecutor *)executor
                            withBlock:(AWSContinuationBlock)block;
 
+/*!
+ Enqueues the given block to be run once this task is complete.
+ @param executor A BFExecutor responsible for determining how the
+ continuation block will be run.
+ @param block The block to be run once this task is complete.
+ @param cancellationToken The cancellation token. If it is cancelled by the time
+ the continuation runs, the block is not run and the returned task is cancelled.
+ @returns A task that will be completed after block has run.
+ If block returns a AWSTask, then the task returned from
+ this method will not be completed until that task is completed.
+ */
+- (instancetype)continueWithExecutor:(AWSExecutor *)executor
+                           withBlock:(AWSContinuationBlock)block
+                   cancellationToken:(AWSCancellationToken *)cancellationToken;
+
 /*!
  Identical to continueWithBlock:, except that the block is only run
  if this task did not produce a cancellation, error, or exception.
@@ -163,6 +243,19 @@ typedef id(^AWSContinuationBlock)(AWSTask *task);
  */
 - (instancetype)continueWithSuccessBlock:(AWSContinuationBlock)block;
 
+/*!
+ Identical to continueWithBlock:cancellationToken:, except that the block is
+ only run if this task did not produce a cancellation, error, or exception.
+ If it did, then the failure will be propagated to the returned task.
+ @param block The block to be run once this task is complete.
+ @param cancellationToken The cancellation token.
+ @returns A task that will be completed after block has run.
+ If block returns a AWSTask, then the task returned from
+ this method will not be completed until that task is completed.
+ */
+- (instancetype)continueWithSuccessBlock:(AWSContinuationBlock)block
+                       cancellationToken:(AWSCancellationToken *)cancellationToken;
+
 /*!
  Identical to continueWithExecutor:withBlock:, except that the block
  is only run if this task did not produce a cancellation, error, or
@@ -178,6 +271,22 @@ typedef id(^AWSContinuationBlock)(AWSTask *task);
 - (instancetype)continueWithExecutor:(AWSExecutor *)executor
                     withSuccessBlock:(AWSContinuationBlock)block;
 
+/*!
+ Identical to continueWithExecutor:withBlock:cancellationToken:, except that
+ the block is only run if this task did not produce a cancellation, error, or
+ exception. If it did, then the failure will be propagated to the returned task.
+ @param executor A BFExecutor responsible for determining how the
+ continuation block will be run.
+ @param block The block to be run once this task is complete.
+ @param cancellationToken The cancellation token.
+ @returns A task that will be completed after block has run.
+ If block returns a AWSTask, then the task returned from
+ this method will not be completed until that task is completed.
+ */
+- (instancetype)continueWithExecutor:(AWSExecutor *)executor
+                    withSuccessBlock:(AWSContinuationBlock)block
+                   cancellationToken:(AWSCancellationToken *)cancellationToken;
+
 /*!
  Waits until this operation is completed.
  This method is inefficient and consumes a thread resource while
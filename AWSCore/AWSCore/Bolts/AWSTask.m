@@ -19,6 +19,10 @@ __attribute__ ((noinline)) void awsbf_warnBlockingOperationOnMainThread() {
           " Break on warnBlockingOperationOnMainThread() to debug.");
 }
 
+// Defined in AWSExecutor.m.
+extern BOOL AWSExecutorEnterInlineExecution(AWSExecutor *executor);
+extern void AWSExecutorExitInlineExecution(void);
+
 NSString *const AWSTaskErrorDomain = @"bolts";
 NSString *const AWSTaskMultipleExceptionsException = @"BFMultipleExceptionsException";
 
@@ -38,6 +42,124 @@ NSString *const AWSTaskMultipleExceptionsException = @"BFMultipleExceptionsExcep
 
 @end
 
+// Runs the tasks of taskForCompletionOfTasksWithObjects:maxConcurrentTaskCount:cancellationToken:progressBlock:block:.
+@interface AWSTaskObjectsRunner : NSObject
+
+@property (nonatomic, strong) NSArray *objects;
+@property (nonatomic, assign) NSUInteger maxConcurrentTaskCount;
+@property (nonatomic, copy) AWSTaskProgressBlock progressBlock;
+@property (nonatomic, copy) AWSTaskObjectBlock block;
+@property (nonatomic, strong) AWSCancellationTokenSource *cancellationTokenSource;
+@property (nonatomic, strong) AWSCancellationTokenRegistration *cancellationTokenRegistration;
+@property (nonatomic, strong) AWSTaskCompletionSource *taskCompletionSource;
+
+// Guarded by @synchronized(self).
+@property (nonatomic, strong) NSMutableArray *results;
+@property (nonatomic, assign) NSUInteger nextIndex;
+@property (nonatomic, assign) NSUInteger runningCount;
+@property (nonatomic, assign) NSUInteger completedCount;
+@property (nonatomic, strong) NSError *error;
+@property (nonatomic, strong) NSException *exception;
+@property (nonatomic, assign) BOOL finished;
+
+@end
+
+@implementation AWSTaskObjectsRunner
+
+- (void)startTasks {
+    while (YES) {
+        NSUInteger index = 0;
+        BOOL finish = NO;
+        @synchronized (self) {
+            if (self.finished) {
+                return;
+            }
+            BOOL stopped = self.error || self.exception || self.cancellationTokenSource.cancellationRequested;
+            if (stopped || self.nextIndex == [self.objects count]) {
+                if (self.runningCount > 0) {
+                    // The last running task to complete finishes.
+                    return;
+                }
+                self.finished = YES;
+                finish = YES;
+            } else if (self.runningCount >= self.maxConcurrentTaskCount) {
+                return;
+            } else {
+                index = self.nextIndex++;
+                self.runningCount++;
+            }
+        }
+        if (finish) {
+            [self finish];
+            return;
+        }
+
+        AWSTask *task = nil;
+        @try {
+            task = self.block(self.objects[index], index, self.cancellationTokenSource.token);
+        } @catch (NSException *exception) {
+            task = [AWSTask taskWithException:exception];
+        }
+        if (!task) {
+            task = [AWSTask taskWithResult:nil];
+        }
+        [task continueWithBlock:^id(AWSTask *task) {
+            [self taskAtIndex:index didCompleteWithTask:task];
+            return nil;
+        }];
+    }
+}
+
+- (void)taskAtIndex:(NSUInteger)index didCompleteWithTask:(AWSTask *)task {
+    BOOL stopTasks = NO;
+    NSUInteger completedCount = 0;
+    @synchronized (self) {
+        self.runningCount--;
+        BOOL firstFailure = !self.exception && !self.error;
+        if (task.exception) {
+            if (firstFailure) {
+                self.exception = task.exception;
+            }
+            stopTasks = YES;
+        } else if (task.error) {
+            if (firstFailure) {
+                self.error = task.error;
+            }
+            stopTasks = YES;
+        } else if (task.cancelled) {
+            stopTasks = YES;
+        } else {
+            if (task.result) {
+                self.results[index] = task.result;
+            }
+            completedCount = ++self.completedCount;
+        }
+    }
+
+    if (stopTasks) {
+        // Outside the lock, as the running tasks observe the token.
+        [self.cancellationTokenSource cancel];
+    } else if (self.progressBlock) {
+        self.progressBlock(completedCount, [self.objects count]);
+    }
+    [self startTasks];
+}
+
+- (void)finish {
+    [self.cancellationTokenRegistration dispose];
+    if (self.exception) {
+        self.taskCompletionSource.exception = self.exception;
+    } else if (self.error) {
+        self.taskCompletionSource.error = self.error;
+    } else if (self.cancellationTokenSource.cancellationRequested) {
+        [self.taskCompletionSource cancel];
+    } else {
+        self.taskCompletionSource.result = [self.results copy];
+    }
+}
+
+@end
+
 @implementation AWSTask
 
 #pragma mark - Initializer
@@ -141,6 +263,99 @@ NSString *const AWSTaskMultipleExceptionsException = @"BFMultipleExceptionsExcep
     }];
 }
 
++ (instancetype)taskForCompletionOfAnyTask:(NSArray *)tasks {
+    __block int32_t total = (int32_t)tasks.count;
+    if (total == 0) {
+        return [self taskWithResult:nil];
+    }
+
+    __block int32_t cancelled = 0;
+    NSObject *lock = [[NSObject alloc] init];
+    NSMutableArray *errors = [NSMutableArray array];
+    NSMutableArray *exceptions = [NSMutableArray array];
+
+    AWSTaskCompletionSource *tcs = [AWSTaskCompletionSource taskCompletionSource];
+    for (AWSTask *task in tasks) {
+        [task continueWithBlock:^id(AWSTask *task) {
+            if (task.exception) {
+                @synchronized (lock) {
+                    [exceptions addObject:task.exception];
+                }
+            } else if (task.error) {
+                @synchronized (lock) {
+                    [errors addObject:task.error];
+                }
+            } else if (task.cancelled) {
+                OSAtomicIncrement32(&cancelled);
+            } else {
+                [tcs trySetResult:task.result];
+            }
+
+            if (OSAtomicDecrement32(&total) == 0) {
+                if (exceptions.count > 0) {
+                    if (exceptions.count == 1) {
+                        [tcs trySetException:[exceptions firstObject]];
+                    } else {
+                        NSException *exception =
+                        [NSException exceptionWithName:AWSTaskMultipleExceptionsException
+                                                reason:@"There were multiple exceptions."
+                                              userInfo:@{ @"exceptions": exceptions }];
+                        [tcs trySetException:exception];
+                    }
+                } else if (errors.count > 0) {
+                    if (errors.count == 1) {
+                        [tcs trySetError:[errors firstObject]];
+                    } else {
+                        NSError *error = [NSError errorWithDomain:AWSTaskErrorDomain
+                                                             code:kAWSMultipleErrorsError
+                                                         userInfo:@{ @"errors": errors }];
+                        [tcs trySetError:error];
+                    }
+                } else if (cancelled > 0) {
+                    [tcs trySetCancelled];
+                }
+            }
+            return nil;
+        }];
+    }
+    return tcs.task;
+}
+
++ (instancetype)taskForCompletionOfTasksWithObjects:(NSArray *)objects
+                             maxConcurrentTaskCount:(NSUInteger)maxConcurrentTaskCount
+                                  cancellationToken:(AWSCancellationToken *)cancellationToken
+                                      progressBlock:(AWSTaskProgressBlock)progressBlock
+                                              block:(AWSTaskObjectBlock)block {
+    if (cancellationToken.cancellationRequested) {
+        return [self cancelledTask];
+    }
+    if ([objects count] == 0) {
+        return [self taskWithResult:@[]];
+    }
+
+    AWSTaskObjectsRunner *runner = [AWSTaskObjectsRunner new];
+    runner.objects = [objects copy];
+    runner.maxConcurrentTaskCount = maxConcurrentTaskCount == 0 ? NSUIntegerMax : maxConcurrentTaskCount;
+    runner.progressBlock = progressBlock;
+    runner.block = block;
+    runner.taskCompletionSource = [AWSTaskCompletionSource taskCompletionSource];
+    runner.results = [NSMutableArray arrayWithCapacity:[objects count]];
+    for (NSUInteger i = 0; i < [objects count]; i++) {
+        [runner.results addObject:[NSNull null]];
+    }
+
+    // The runner has a token source of its own, so that a failed task can stop its siblings
+    // without cancelling the caller's token. Cancelling the caller's token cancels it too.
+    AWSCancellationTokenSource *cancellationTokenSource = [AWSCancellationTokenSource cancellationTokenSource];
+    runner.cancellationTokenSource = cancellationTokenSource;
+    runner.cancellationTokenRegistration = [cancellationToken registerCancellationObserverWithBlock:^{
+        [cancellationTokenSource cancel];
+    }];
+
+    [runner startTasks];
+    return runner.taskCompletionSource.task;
+}
+
 + (instancetype)taskWithDelay:(int)millis {
     AWSTaskCompletionSource *tcs = [AWSTaskCompletionSource taskCompletionSource];
     dispatch_time_t popTime = dispatch_time(DISPATCH_TIME_NOW, millis * NSEC_PER_MSEC);
@@ -150,6 +365,24 @@ NSString *const AWSTaskMultipleExceptionsException = @"BFMultipleExceptionsExcep
     return tcs.task;
 }
 
++ (instancetype)taskWithDelay:(int)millis
+            cancellationToken:(AWSCancellationToken *)token {
+    if (token.cancellationRequested) {
+        return [AWSTask cancelledTask];
+    }
+
+    AWSTaskCompletionSource *tcs = [AWSTaskCompletionSource taskCompletionSource];
+    AWSCancellationTokenRegistration *registration = [token registerCancellationObserverWithBlock:^{
+        [tcs trySetCancelled];
+    }];
+    dispatch_time_t popTime = dispatch_time(DISPATCH_TIME_NOW, millis * NSEC_PER_MSEC);
+    dispatch_after(popTime, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(void){
+        [registration dispose];
+        [tcs trySetResult:nil];
+    });
+    return tcs.task;
+}
+
 + (instancetype)taskFromExecutor:(AWSExecutor *)executor
                        withBlock:(id (^)())block {
     return [[self taskWithResult:nil] continueWithExecutor:executor withBlock:block];
@@ -295,11 +528,44 @@ NSString *const AWSTaskMultipleExceptionsException = @"BFMultipleExceptionsExcep
 
 - (instancetype)continueWithExecutor:(AWSExecutor *)executor
                            withBlock:(AWSContinuationBlock)block {
+    return [self continueWithExecutor:executor withBlock:block cancellationToken:nil];
+}
+
+- (instancetype)continueWithExecutor:(AWSExecutor *)executor
+                           withBlock:(AWSContinuationBlock)block
+                   cancellationToken:(AWSCancellationToken *)cancellationToken {
+    // A completed task never changes, so when the executor would run the continuation right here anyway, it is
+    // run directly and its result returned, without the completion source and blocks of the general path.
+    if (self.completed && AWSExecutorEnterInlineExecution(executor)) {
+        if (cancellationToken.cancellationRequested) {
+            AWSExecutorExitInlineExecution();
+            return [AWSTask cancelledTask];
+        }
+
+        id result = nil;
+        @try {
+            result = block(self);
+        } @catch (NSException *exception) {
+            return [AWSTask taskWithException:exception];
+        } @finally {
+            AWSExecutorExitInlineExecution();
+        }
+        if ([result isKindOfClass:[AWSTask class]]) {
+            return result;
+        }
+        return [AWSTask taskWithResult:result];
+    }
+
     AWSTaskCompletionSource *tcs = [AWSTaskCompletionSource taskCompletionSource];
 
     // Capture all of the state that needs to used when the continuation is complete.
     void (^wrappedBlock)() = ^() {
         [executor execute:^{
+            if (cancellationToken.cancellationRequested) {
+                [tcs cancel];
+                return;
+            }
+
             id result = nil;
             @try {
                 result = block(self);
@@ -341,22 +607,46 @@ NSString *const AWSTaskMultipleExceptionsException = @"BFMultipleExceptionsExcep
 }
 
 - (instancetype)continueWithBlock:(AWSContinuationBlock)block {
-    return [self continueWithExecutor:[AWSExecutor defaultExecutor] withBlock:block];
+    return [self continueWithExecutor:[AWSExecutor defaultExecutor] withBlock:block cancellationToken:nil];
+}
+
+- (instancetype)continueWithBlock:(AWSContinuationBlock)block
+                cancellationToken:(AWSCancellationToken *)cancellationToken {
+    return [self continueWithExecutor:[AWSExecutor defaultExecutor] withBlock:block cancellationToken:cancellationToken];
 }
 
 - (instancetype)continueWithExecutor:(AWSExecutor *)executor
                     withSuccessBlock:(AWSContinuationBlock)block {
+    return [self continueWithExecutor:executor withSuccessBlock:block cancellationToken:nil];
+}
+
+- (instancetype)continueWithExecutor:(AWSExecutor *)executor
+                    withSuccessBlock:(AWSContinuationBlock)block
+                   cancellationToken:(AWSCancellationToken *)cancellationToken {
+    if (self.completed) {
+        // The outcome is already known, so the wrapping block is not needed.
+        if (self.faulted || self.cancelled) {
+            return self;
+        }
+        return [self continueWithExecutor:executor withBlock:block cancellationToken:cancellationToken];
+    }
+
     return [self continueWithExecutor:executor withBlock:^id(AWSTask *task) {
         if (task.faulted || task.cancelled) {
             return task;
         } else {
             return block(task);
         }
-    }];
+    } cancellationToken:cancellationToken];
 }
 
 - (instancetype)continueWithSuccessBlock:(AWSContinuationBlock)block {
-    return [self continueWithExecutor:[AWSExecutor defaultExecutor] withSuccessBlock:block];
+    return [self continueWithExecutor:[AWSExecutor defaultExecutor] withSuccessBlock:block cancellationToken:nil];
+}
+
+- (instancetype)continueWithSuccessBlock:(AWSContinuationBlock)block
+                       cancellationToken:(AWSCancellationToken *)cancellationToken {
+    return [self continueWithExecutor:[AWSExecutor defaultExecutor] withSuccessBlock:block cancellationToken:cancellationToken];
 }
 
 #pragma mark - Syncing Task (Avoid it)
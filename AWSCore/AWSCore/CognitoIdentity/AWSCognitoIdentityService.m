@@ -231,10 +231,12 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
         }
         
         AWSNetworkingRequest *networkingRequest = request.internalRequest;
-        if (request) {
-            networkingRequest.parameters = [[AWSMTLJSONAdapter JSONDictionaryFromModel:request] aws_removeNullValues];
-        } else {
+        AWSJSONRequestSerializer *requestSerializer = [[AWSJSONRequestSerializer alloc] initWithJSONDefinition:[[AWSCognitoIdentityResources sharedInstance] JSONObject]
+                                                                                                    actionName:operationName];
+        if ([requestSerializer encodeBodyFromModel:request]) {
             networkingRequest.parameters = @{};
+        } else {
+            networkingRequest.parameters = [[AWSMTLJSONAdapter JSONDictionaryFromModel:request] aws_removeNullValues];
         }
         
         NSMutableDictionary *parameters = [NSMutableDictionary new];
@@ -256,8 +258,7 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
         networkingRequest.headers = headers;
         networkingRequest.URLString = blockSafeURLString;
         networkingRequest.HTTPMethod = HTTPMethod;
-        networkingRequest.requestSerializer = [[AWSJSONRequestSerializer alloc] initWithJSONDefinition:[[AWSCognitoIdentityResources sharedInstance] JSONObject]
-                                                                                            actionName:operationName];
+        networkingRequest.requestSerializer = requestSerializer;
         networkingRequest.responseSerializer = [[AWSCognitoIdentityResponseSerializer alloc] initWithJSONDefinition:[[AWSCognitoIdentityResources sharedInstance] JSONObject]
                                                                                                          actionName:operationName
                                                                                                         outputClass:outputClass];
@@ -35,6 +35,15 @@
 
 void awsgzip_loadGZIP();
 
+FOUNDATION_EXPORT NSString *const AWSGZIPErrorDomain;
+
+typedef NS_ENUM(NSInteger, AWSGZIPErrorType)
+{
+    AWSGZIPErrorUnknown,
+    AWSGZIPErrorCompression,
+    AWSGZIPErrorDecompression,
+};
+
 @interface NSData (AWSGZIP)
 
 - (NSData *)awsgzip_gzippedDataWithCompressionLevel:(float)level;
@@ -42,3 +51,25 @@ void awsgzip_loadGZIP();
 - (NSData *)awsgzip_gunzippedData;
 
 @end
+
+/**
+ * An output stream that gzips the bytes written to it and writes the result
+ * to another output stream, so a body can be compressed as it is produced.
+ * Closing the stream writes the gzip trailer and closes the wrapped stream.
+ **/
+@interface AWSGZIPOutputStream : NSOutputStream <NSStreamDelegate>
+
+- (instancetype)initWithOutputStream:(NSOutputStream *)stream;
+- (instancetype)initWithOutputStream:(NSOutputStream *)stream compressionLevel:(float)level;
+
+@end
+
+/**
+ * An input stream that gunzips the bytes of another input stream as they are read,
+ * so a compressed body can be consumed without inflating it into memory first.
+ **/
+@interface AWSGUNZIPInputStream : NSInputStream <NSStreamDelegate>
+
+- (instancetype)initWithInputStream:(NSInputStream *)stream;
+
+@end
@@ -37,8 +37,20 @@
 void awsgzip_loadGZIP(){
 }
 
+NSString *const AWSGZIPErrorDomain = @"com.amazonaws.AWSGZIPErrorDomain";
+
 static const NSUInteger ChunkSize = 16384;
 
+static NSError *awsgzip_error(AWSGZIPErrorType code, z_stream *stream)
+{
+    NSDictionary *userInfo = nil;
+    if (stream->msg)
+    {
+        userInfo = @{NSLocalizedDescriptionKey: @(stream->msg)};
+    }
+    return [NSError errorWithDomain:AWSGZIPErrorDomain code:code userInfo:userInfo];
+}
+
 
 @implementation NSData (AWSGZIP)
 
@@ -58,7 +70,8 @@ static const NSUInteger ChunkSize = 16384;
         int compression = (level < 0.0f)? Z_DEFAULT_COMPRESSION: (int)(roundf(level * 9));
         if (deflateInit2(&stream, compression, Z_DEFLATED, 31, 8, Z_DEFAULT_STRATEGY) == Z_OK)
         {
-            NSMutableData *data = [NSMutableData dataWithLength:ChunkSize];
+            //deflateBound() covers the whole output, so the buffer only grows if zlib ever exceeds it
+            NSMutableData *data = [NSMutableData dataWithLength:deflateBound(&stream, (uLong)[self length])];
             while (stream.avail_out == 0)
             {
                 if (stream.total_out >= [data length])
@@ -82,6 +95,24 @@ static const NSUInteger ChunkSize = 16384;
     return [self awsgzip_gzippedDataWithCompressionLevel:-1.0f];
 }
 
+- (NSUInteger)awsgzip_estimatedGunzippedLength
+{
+    //the gzip trailer ends with the uncompressed size modulo 2^32 (ISIZE), which is
+    //exact for single member payloads; fall back to the old guess if it looks wrong
+    NSUInteger length = [self length];
+    NSUInteger estimate = length + length / 2;
+    if (length >= 18)
+    {
+        const uint8_t *trailer = (const uint8_t *)[self bytes] + length - 4;
+        uint32_t size = (uint32_t)trailer[0] | ((uint32_t)trailer[1] << 8) | ((uint32_t)trailer[2] << 16) | ((uint32_t)trailer[3] << 24);
+        if (size > 0 && size / 1032 <= length)
+        {
+            estimate = size;
+        }
+    }
+    return MAX(estimate, ChunkSize);
+}
+
 - (NSData *)awsgzip_gunzippedData
 {
     if ([self length])
@@ -89,12 +120,13 @@ static const NSUInteger ChunkSize = 16384;
         z_stream stream;
         stream.zalloc = Z_NULL;
         stream.zfree = Z_NULL;
+        stream.opaque = Z_NULL;
         stream.avail_in = (uint)[self length];
         stream.next_in = (Bytef *)[self bytes];
         stream.total_out = 0;
         stream.avail_out = 0;
         
-        NSMutableData *data = [NSMutableData dataWithLength:(NSUInteger)([self length] * 1.5)];
+        NSMutableData *data = [NSMutableData dataWithLength:[self awsgzip_estimatedGunzippedLength]];
         if (inflateInit2(&stream, 47) == Z_OK)
         {
             int status = Z_OK;
@@ -102,11 +134,11 @@ static const NSUInteger ChunkSize = 16384;
             {
                 if (stream.total_out >= [data length])
                 {
-                    data.length += [self length] / 2;
+                    data.length += MAX([data length] / 2, ChunkSize);
                 }
                 stream.next_out = (uint8_t *)[data mutableBytes] + stream.total_out;
                 stream.avail_out = (uInt)([data length] - stream.total_out);
-                status = inflate (&stream, Z_SYNC_FLUSH);
+                status = inflate (&stream, Z_NO_FLUSH);
             }
             if (inflateEnd(&stream) == Z_OK)
             {
@@ -122,3 +154,395 @@ static const NSUInteger ChunkSize = 16384;
 }
 
 @end
+
+
+@interface AWSGZIPOutputStream ()
+
+@property (nonatomic, weak) id<NSStreamDelegate> delegate;
+
+// underlying output stream receiving the compressed bytes
+@property (nonatomic, strong) NSOutputStream *stream;
+@property (nonatomic, strong) NSMutableData *outputBuffer;
+@property (nonatomic, strong) NSError *error;
+
+@end
+
+@implementation AWSGZIPOutputStream
+{
+    z_stream _zstream;
+    int _compression;
+    BOOL _deflating;
+}
+
+@synthesize delegate = _delegate;
+
+- (instancetype)initWithOutputStream:(NSOutputStream *)stream
+{
+    return [self initWithOutputStream:stream compressionLevel:-1.0f];
+}
+
+- (instancetype)initWithOutputStream:(NSOutputStream *)stream compressionLevel:(float)level
+{
+    if ((self = [super init]))
+    {
+        _stream = stream;
+        _stream.delegate = self;
+        _outputBuffer = [NSMutableData dataWithLength:ChunkSize];
+        _compression = (level < 0.0f)? Z_DEFAULT_COMPRESSION: (int)(roundf(level * 9));
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    if (_deflating)
+    {
+        deflateEnd(&_zstream);
+    }
+}
+
+- (void)stream:(NSStream *)aStream handleEvent:(NSStreamEvent)eventCode
+{
+    if ([self.delegate respondsToSelector:@selector(stream:handleEvent:)])
+    {
+        [self.delegate stream:self handleEvent:eventCode];
+    }
+}
+
+- (BOOL)writeCompressedBytes:(const uint8_t *)bytes length:(NSUInteger)length
+{
+    while (length > 0)
+    {
+        NSInteger written = [self.stream write:bytes maxLength:length];
+        if (written <= 0)
+        {
+            self.error = [self.stream streamError];
+            return NO;
+        }
+        bytes += written;
+        length -= written;
+    }
+    return YES;
+}
+
+- (BOOL)deflateWithFlush:(int)flush
+{
+    //deflate() has consumed all input, or written the whole trailer with Z_FINISH, once it leaves room in the buffer
+    do
+    {
+        _zstream.next_out = [self.outputBuffer mutableBytes];
+        _zstream.avail_out = (uInt)[self.outputBuffer length];
+        if (deflate(&_zstream, flush) == Z_STREAM_ERROR)
+        {
+            self.error = awsgzip_error(AWSGZIPErrorCompression, &_zstream);
+            return NO;
+        }
+        if (![self writeCompressedBytes:[self.outputBuffer bytes] length:[self.outputBuffer length] - _zstream.avail_out])
+        {
+            return NO;
+        }
+    }
+    while (_zstream.avail_out == 0);
+    return YES;
+}
+
+#pragma mark NSOutputStream methods
+
+- (NSInteger)write:(const uint8_t *)buffer maxLength:(NSUInteger)len
+{
+    if (!_deflating || self.error)
+    {
+        return -1;
+    }
+
+    uInt length = (uInt)MIN(len, (NSUInteger)UINT_MAX);
+    _zstream.next_in = (Bytef *)buffer;
+    _zstream.avail_in = length;
+    if (![self deflateWithFlush:Z_NO_FLUSH])
+    {
+        return -1;
+    }
+    return (NSInteger)length;
+}
+
+- (BOOL)hasSpaceAvailable
+{
+    return _deflating && !self.error && [self.stream hasSpaceAvailable];
+}
+
+- (void)open
+{
+    memset(&_zstream, 0, sizeof(_zstream));
+    if (deflateInit2(&_zstream, _compression, Z_DEFLATED, 31, 8, Z_DEFAULT_STRATEGY) == Z_OK)
+    {
+        _deflating = YES;
+    }
+    else
+    {
+        self.error = awsgzip_error(AWSGZIPErrorCompression, &_zstream);
+    }
+    [self.stream open];
+}
+
+- (void)close
+{
+    if (_deflating)
+    {
+        if (!self.error)
+        {
+            [self deflateWithFlush:Z_FINISH];
+        }
+        deflateEnd(&_zstream);
+        _deflating = NO;
+    }
+    [self.stream close];
+}
+
+- (void)setDelegate:(id)delegate
+{
+    _delegate = delegate;
+}
+
+- (void)scheduleInRunLoop:(NSRunLoop *)aRunLoop forMode:(NSString *)mode
+{
+    [self.stream scheduleInRunLoop:aRunLoop forMode:mode];
+}
+
+- (void)removeFromRunLoop:(NSRunLoop *)aRunLoop forMode:(NSString *)mode
+{
+    [self.stream removeFromRunLoop:aRunLoop forMode:mode];
+}
+
+- (id)propertyForKey:(NSString *)key
+{
+    return [self.stream propertyForKey:key];
+}
+
+- (BOOL)setProperty:(id)property forKey:(NSString *)key
+{
+    //offsets into the compressed bytes do not map onto the written ones
+    return NO;
+}
+
+- (NSStreamStatus)streamStatus
+{
+    return self.error? NSStreamStatusError: [self.stream streamStatus];
+}
+
+- (NSError *)streamError
+{
+    return self.error ?: [self.stream streamError];
+}
+
+- (NSMethodSignature *)methodSignatureForSelector:(SEL)aSelector
+{
+    return [self.stream methodSignatureForSelector:aSelector];
+}
+
+- (void)forwardInvocation:(NSInvocation *)anInvocation
+{
+    [anInvocation invokeWithTarget:self.stream];
+}
+
+@end
+
+
+@interface AWSGUNZIPInputStream ()
+
+@property (nonatomic, weak) id<NSStreamDelegate> delegate;
+
+// underlying compressed input stream
+@property (nonatomic, strong) NSInputStream *stream;
+@property (nonatomic, strong) NSMutableData *inputBuffer;
+@property (nonatomic, strong) NSError *error;
+
+@end
+
+@implementation AWSGUNZIPInputStream
+{
+    z_stream _zstream;
+    BOOL _inflating;
+    BOOL _sourceAtEnd;
+    BOOL _finished;
+}
+
+@synthesize delegate = _delegate;
+
+- (instancetype)initWithInputStream:(NSInputStream *)stream
+{
+    if ((self = [super init]))
+    {
+        _stream = stream;
+        _stream.delegate = self;
+        _inputBuffer = [NSMutableData dataWithLength:ChunkSize];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    if (_inflating)
+    {
+        inflateEnd(&_zstream);
+    }
+}
+
+- (void)stream:(NSStream *)aStream handleEvent:(NSStreamEvent)eventCode
+{
+    if ((eventCode & NSStreamEventEndEncountered) && !_finished)
+    {
+        //inflated bytes are still to be read
+        eventCode ^= NSStreamEventEndEncountered;
+        eventCode |= NSStreamEventHasBytesAvailable;
+    }
+    if ([self.delegate respondsToSelector:@selector(stream:handleEvent:)])
+    {
+        [self.delegate stream:self handleEvent:eventCode];
+    }
+}
+
+#pragma mark NSInputStream methods
+
+- (NSInteger)read:(uint8_t *)buffer maxLength:(NSUInteger)len
+{
+    if (_finished)
+    {
+        return 0;
+    }
+    if (!_inflating || self.error)
+    {
+        return -1;
+    }
+
+    uInt capacity = (uInt)MIN(len, (NSUInteger)UINT_MAX);
+    _zstream.next_out = buffer;
+    _zstream.avail_out = capacity;
+    while (_zstream.avail_out == capacity && !_finished)
+    {
+        if (_zstream.avail_in == 0)
+        {
+            if (_sourceAtEnd)
+            {
+                //the source ended before the gzip trailer
+                self.error = awsgzip_error(AWSGZIPErrorDecompression, &_zstream);
+                return -1;
+            }
+            NSInteger read = [self.stream read:[self.inputBuffer mutableBytes] maxLength:[self.inputBuffer length]];
+            if (read < 0)
+            {
+                self.error = [self.stream streamError];
+                return -1;
+            }
+            if (read == 0)
+            {
+                _sourceAtEnd = YES;
+                continue;
+            }
+            _zstream.next_in = [self.inputBuffer mutableBytes];
+            _zstream.avail_in = (uInt)read;
+        }
+
+        int status = inflate(&_zstream, Z_NO_FLUSH);
+        if (status == Z_STREAM_END)
+        {
+            _finished = YES;
+        }
+        else if (status != Z_OK && status != Z_BUF_ERROR)
+        {
+            self.error = awsgzip_error(AWSGZIPErrorDecompression, &_zstream);
+            return -1;
+        }
+    }
+    return (NSInteger)(capacity - _zstream.avail_out);
+}
+
+- (BOOL)hasBytesAvailable
+{
+    return !_finished;
+}
+
+- (BOOL)getBuffer:(uint8_t **)buffer length:(NSUInteger *)len
+{
+    return NO;
+}
+
+- (void)open
+{
+    memset(&_zstream, 0, sizeof(_zstream));
+    if (inflateInit2(&_zstream, 47) == Z_OK)
+    {
+        _inflating = YES;
+    }
+    else
+    {
+        self.error = awsgzip_error(AWSGZIPErrorDecompression, &_zstream);
+    }
+    [self.stream open];
+}
+
+- (void)close
+{
+    [self.stream close];
+    if (_inflating)
+    {
+        inflateEnd(&_zstream);
+        _inflating = NO;
+    }
+}
+
+- (void)setDelegate:(id)delegate
+{
+    _delegate = delegate;
+}
+
+- (void)scheduleInRunLoop:(NSRunLoop *)aRunLoop forMode:(NSString *)mode
+{
+    [self.stream scheduleInRunLoop:aRunLoop forMode:mode];
+}
+
+- (void)removeFromRunLoop:(NSRunLoop *)aRunLoop forMode:(NSString *)mode
+{
+    [self.stream removeFromRunLoop:aRunLoop forMode:mode];
+}
+
+- (id)propertyForKey:(NSString *)key
+{
+    return [self.stream propertyForKey:key];
+}
+
+- (BOOL)setProperty:(id)property forKey:(NSString *)key
+{
+    //offsets into the source do not map onto the inflated bytes
+    return NO;
+}
+
+- (NSStreamStatus)streamStatus
+{
+    if (self.error)
+    {
+        return NSStreamStatusError;
+    }
+    NSStreamStatus status = [self.stream streamStatus];
+    if (status == NSStreamStatusOpen || status == NSStreamStatusReading || status == NSStreamStatusAtEnd)
+    {
+        return _finished? NSStreamStatusAtEnd: NSStreamStatusOpen;
+    }
+    return status;
+}
+
+- (NSError *)streamError
+{
+    return self.error ?: [self.stream streamError];
+}
+
+- (NSMethodSignature *)methodSignatureForSelector:(SEL)aSelector
+{
+    return [self.stream methodSignatureForSelector:aSelector];
+}
+
+- (void)forwardInvocation:(NSInvocation *)anInvocation
+{
+    [anInvocation invokeWithTarget:self.stream];
+}
+
+@end
@@ -11,6 +11,7 @@
 #import "AWSEXTRuntimeExtensions.h"
 #import "AWSEXTScope.h"
 #import "AWSMTLReflection.h"
+#import "AWSClassMetadata.h"
 #import <objc/runtime.h>
 
 // This coupling is needed for backwards compatibility in MTLModel's deprecated
@@ -30,22 +31,32 @@ static void *MTLModelCachedPropertyKeysKey = &MTLModelCachedPropertyKeysKey;
 // value       - The new value for the property identified by `key`.
 // forceUpdate - If set to `YES`, the value is being updated even if validating
 //               it did not change it.
+// property    - The cached metadata of the property identified by `key`, or nil
+//               to go through key-value coding.
 // error       - If not NULL, this may be set to any error that occurs during
 //               validation
 //
 // Returns YES if `value` could be validated and set, or NO if an error
 // occurred.
-static BOOL MTLValidateAndSetValue(id obj, NSString *key, id value, BOOL forceUpdate, NSError **error) {
+static BOOL MTLValidateAndSetValue(id obj, NSString *key, id value, BOOL forceUpdate, AWSPropertyMetadata *property, NSError **error) {
 	// Mark this as being autoreleased, because validateValue may return
 	// a new object to be stored in this variable (and we don't want ARC to
 	// double-free or leak the old or new values).
 	__autoreleasing id validatedValue = value;
 
 	@try {
-		if (![obj validateValue:&validatedValue forKey:key error:error]) return NO;
+		// Without a validation method, validateValue:forKey:error: would accept
+		// the value unchanged, so it is skipped.
+		if (property == nil || property.validatesValue) {
+			if (![obj validateValue:&validatedValue forKey:key error:error]) return NO;
+		}
 
 		if (forceUpdate || value != validatedValue) {
-			[obj setValue:validatedValue forKey:key];
+			if (property != nil) {
+				[property setValue:validatedValue forObject:obj];
+			} else {
+				[obj setValue:validatedValue forKey:key];
+			}
 		}
 
 		return YES;
@@ -65,17 +76,6 @@ static BOOL MTLValidateAndSetValue(id obj, NSString *key, id value, BOOL forceUp
 	}
 }
 
-@interface AWSMTLModel ()
-
-// Enumerates all properties of the receiver's class hierarchy, starting at the
-// receiver, and continuing up until (but not including) MTLModel.
-//
-// The given block will be invoked multiple times for any properties declared on
-// multiple classes in the hierarchy.
-+ (void)enumeratePropertiesUsingBlock:(void (^)(objc_property_t property, BOOL *stop))block;
-
-@end
-
 @implementation AWSMTLModel
 
 #pragma mark Lifecycle
@@ -93,6 +93,8 @@ static BOOL MTLValidateAndSetValue(id obj, NSString *key, id value, BOOL forceUp
 	self = [self init];
 	if (self == nil) return nil;
 
+	NSDictionary *properties = [AWSClassMetadata metadataForClass:object_getClass(self)].propertiesByName;
+
 	for (NSString *key in dictionary) {
 		// Mark this as being autoreleased, because validateValue may return
 		// a new object to be stored in this variable (and we don't want ARC to
@@ -101,7 +103,7 @@ static BOOL MTLValidateAndSetValue(id obj, NSString *key, id value, BOOL forceUp
 	
 		if ([value isEqual:NSNull.null]) value = nil;
 
-		BOOL success = MTLValidateAndSetValue(self, key, value, YES, error);
+		BOOL success = MTLValidateAndSetValue(self, key, value, YES, properties[key], error);
 		if (!success) return nil;
 	}
 
@@ -110,45 +112,20 @@ static BOOL MTLValidateAndSetValue(id obj, NSString *key, id value, BOOL forceUp
 
 #pragma mark Reflection
 
-+ (void)enumeratePropertiesUsingBlock:(void (^)(objc_property_t property, BOOL *stop))block {
-	Class cls = self;
-	BOOL stop = NO;
-
-	while (!stop && ![cls isEqual:AWSMTLModel.class]) {
-		unsigned count = 0;
-		objc_property_t *properties = class_copyPropertyList(cls, &count);
-
-		cls = cls.superclass;
-		if (properties == NULL) continue;
-
-		@onExit {
-			free(properties);
-		};
-
-		for (unsigned i = 0; i < count; i++) {
-			block(properties[i], &stop);
-			if (stop) break;
-		}
-	}
-}
-
 + (NSSet *)propertyKeys {
 	NSSet *cachedKeys = objc_getAssociatedObject(self, MTLModelCachedPropertyKeysKey);
 	if (cachedKeys != nil) return cachedKeys;
 
 	NSMutableSet *keys = [NSMutableSet set];
 
-	[self enumeratePropertiesUsingBlock:^(objc_property_t property, BOOL *stop) {
-		awsmtl_propertyAttributes *attributes = awsmtl_copyPropertyAttributes(property);
-		@onExit {
-			free(attributes);
-		};
+	// Properties of the receiver's class hierarchy, up until (but not
+	// including) MTLModel.
+	for (AWSPropertyMetadata *property in [AWSClassMetadata metadataForClass:self].properties) {
+		if (property.declaringClass == AWSMTLModel.class) continue;
+		if (property.readonly && !property.hasIvar) continue;
 
-		if (attributes->readonly && attributes->ivar == NULL) return;
-
-		NSString *key = @(property_getName(property));
-		[keys addObject:key];
-	}];
+		[keys addObject:property.name];
+	}
 
 	// It doesn't really matter if we replace another thread's work, since we do
 	// it atomically and the result should be the same.
@@ -158,7 +135,18 @@ static BOOL MTLValidateAndSetValue(id obj, NSString *key, id value, BOOL forceUp
 }
 
 - (NSDictionary *)dictionaryValue {
-	return [self dictionaryWithValuesForKeys:self.class.propertyKeys.allObjects];
+	NSSet *propertyKeys = self.class.propertyKeys;
+	NSDictionary *properties = [AWSClassMetadata metadataForClass:object_getClass(self)].propertiesByName;
+	NSMutableDictionary *dictionaryValue = [[NSMutableDictionary alloc] initWithCapacity:propertyKeys.count];
+
+	// The same as dictionaryWithValuesForKeys:, through the cached accessors.
+	for (NSString *key in propertyKeys) {
+		AWSPropertyMetadata *property = properties[key];
+		id value = (property != nil ? [property valueForObject:self] : [self valueForKey:key]);
+		dictionaryValue[key] = value ?: NSNull.null;
+	}
+
+	return dictionaryValue;
 }
 
 #pragma mark Merging
@@ -195,10 +183,12 @@ static BOOL MTLValidateAndSetValue(id obj, NSString *key, id value, BOOL forceUp
 #pragma mark Validation
 
 - (BOOL)validate:(NSError **)error {
+	NSDictionary *properties = [AWSClassMetadata metadataForClass:object_getClass(self)].propertiesByName;
+
 	for (NSString *key in self.class.propertyKeys) {
 		id value = [self valueForKey:key];
 
-		BOOL success = MTLValidateAndSetValue(self, key, value, NO, error);
+		BOOL success = MTLValidateAndSetValue(self, key, value, NO, properties[key], error);
 		if (!success) return NO;
 	}
 
@@ -0,0 +1,39 @@
+/*
+ Copyright 2010-2015 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License").
+ You may not use this file except in compliance with the License.
+ A copy of the License is located at
+
+ http://aws.amazon.com/apache2.0
+
+ or in the "license" file accompanying this file. This file is distributed
+ on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ express or implied. See the License for the specific language governing
+ permissions and limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+/**
+ * A subclass of NSInputStream that reads a byte range of a file directly
+ * from disk, so that a slice of a large file can be sent as a request body
+ * without copying it first.
+ *
+ * A stream can only be read once. Copying it returns a new, unopened stream
+ * over the same range, which allows a request to be retried.
+ **/
+@interface AWSFileRangeInputStream : NSInputStream <NSStreamDelegate, NSCopying>
+
+@property (nonatomic, strong, readonly) NSURL *fileURL;
+@property (nonatomic, assign, readonly) unsigned long long offset;
+@property (nonatomic, assign, readonly) unsigned long long length;
+
+/**
+ * Initialize the input stream with the file and the range of bytes to read.
+ **/
+- (instancetype)initWithFileURL:(NSURL *)fileURL
+                         offset:(unsigned long long)offset
+                         length:(unsigned long long)length;
+
+@end
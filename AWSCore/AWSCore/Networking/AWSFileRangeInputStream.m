@@ -0,0 +1,142 @@
+/*
+ Copyright 2010-2015 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License").
+ You may not use this file except in compliance with the License.
+ A copy of the License is located at
+
+ http://aws.amazon.com/apache2.0
+
+ or in the "license" file accompanying this file. This file is distributed
+ on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ express or implied. See the License for the specific language governing
+ permissions and limitations under the License.
+ */
+
+#import "AWSFileRangeInputStream.h"
+#import "AWSLogging.h"
+
+@interface AWSFileRangeInputStream()
+
+@property (nonatomic, weak) id<NSStreamDelegate> delegate;
+
+// underlying file input stream
+@property (nonatomic, strong) NSInputStream *stream;
+
+// number of bytes left in the range
+@property (nonatomic, assign) unsigned long long remainingLength;
+
+@end
+
+@implementation AWSFileRangeInputStream
+
+@synthesize delegate = _delegate;
+
+- (instancetype)initWithFileURL:(NSURL *)fileURL
+                         offset:(unsigned long long)offset
+                         length:(unsigned long long)length {
+    if (self = [super init]) {
+        _fileURL = fileURL;
+        _offset = offset;
+        _length = length;
+        _remainingLength = length;
+        _stream = [NSInputStream inputStreamWithURL:fileURL];
+        _stream.delegate = self;
+    }
+
+    return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    return [[[self class] allocWithZone:zone] initWithFileURL:self.fileURL
+                                                       offset:self.offset
+                                                       length:self.length];
+}
+
+- (void)stream:(NSStream *)aStream handleEvent:(NSStreamEvent)eventCode {
+    if ([self.delegate respondsToSelector:@selector(stream:handleEvent:)]) {
+        [self.delegate stream:self handleEvent:eventCode];
+    }
+}
+
+#pragma mark NSInputStream methods
+
+- (NSInteger)read:(uint8_t *)buffer maxLength:(NSUInteger)len {
+    if (self.remainingLength == 0) {
+        return 0;
+    }
+
+    NSInteger read = [self.stream read:buffer maxLength:(NSUInteger)MIN((unsigned long long)len, self.remainingLength)];
+    if (read > 0) {
+        self.remainingLength -= read;
+    }
+
+    return read;
+}
+
+- (BOOL)hasBytesAvailable {
+    return self.remainingLength > 0 && [self.stream hasBytesAvailable];
+}
+
+- (BOOL)getBuffer:(uint8_t **)buffer length:(NSUInteger *)len {
+    return NO;
+}
+
+- (void)open {
+    [self.stream open];
+    if (self.offset > 0
+        && ![self.stream setProperty:@(self.offset) forKey:NSStreamFileCurrentOffsetKey]) {
+        AWSLogError(@"Failed to seek to offset %llu of the file: %@", self.offset, self.fileURL);
+    }
+}
+
+- (void)close {
+    [self.stream close];
+}
+
+- (void)setDelegate:(id)delegate {
+    if (delegate == nil) {
+        _delegate = nil;
+    } else {
+        _delegate = delegate;
+    }
+}
+
+- (void)scheduleInRunLoop:(NSRunLoop *)aRunLoop forMode:(NSString *)mode {
+    [self.stream scheduleInRunLoop:aRunLoop forMode:mode];
+}
+
+- (void)removeFromRunLoop:(NSRunLoop *)aRunLoop forMode:(NSString *)mode {
+    [self.stream removeFromRunLoop:aRunLoop forMode:mode];
+}
+
+- (id)propertyForKey:(NSString *)key {
+    return [self.stream propertyForKey:key];
+}
+
+- (BOOL)setProperty:(id)property forKey:(NSString *)key {
+    return [self.stream setProperty:property forKey:key];
+}
+
+- (NSStreamStatus)streamStatus {
+    NSStreamStatus status = [self.stream streamStatus];
+    if (self.remainingLength == 0
+        && (status == NSStreamStatusOpen || status == NSStreamStatusReading)) {
+        return NSStreamStatusAtEnd;
+    }
+    return status;
+}
+
+- (NSError *)streamError {
+    return [self.stream streamError];
+}
+
+- (NSMethodSignature *)methodSignatureForSelector:(SEL)aSelector {
+    return [self.stream methodSignatureForSelector:aSelector];
+}
+
+- (void)forwardInvocation:(NSInvocation *)anInvocation {
+    [anInvocation invokeWithTarget:self.stream];
+}
+
+@end
@@ -33,6 +33,7 @@ typedef NS_ENUM(NSInteger, AWSNetworkingRetryType) {
 @class AWSNetworkingConfiguration;
 @class AWSNetworkingRequest;
 @class AWSTask;
+@protocol AWSHTTPURLResponseDecoder;
 
 typedef void (^AWSNetworkingUploadProgressBlock) (int64_t bytesSent, int64_t totalBytesSent, int64_t totalBytesExpectedToSend);
 typedef void (^AWSNetworkingDownloadProgressBlock) (int64_t bytesWritten, int64_t totalBytesWritten, int64_t totalBytesExpectedToWrite);
@@ -109,6 +110,21 @@ typedef NS_ENUM(NSInteger, AWSHTTPMethod) {
                            data:(id)data
                           error:(NSError *__autoreleasing *)error;
 
+@optional
+
+/**
+ Returns a decoder to feed the body of the response to while it is being received, or `nil` to receive the whole body first. The decoder is then passed as the `data` of `responseObjectForResponse:originalRequest:currentRequest:data:error:`.
+ */
+- (id<AWSHTTPURLResponseDecoder>)responseDecoderForResponse:(NSHTTPURLResponse *)response;
+
+@end
+
+@protocol AWSHTTPURLResponseDecoder <NSObject>
+
+@required
+
+- (void)appendData:(NSData *)data;
+
 @end
 
 @protocol AWSURLRequestRetryHandler <NSObject>
@@ -171,6 +187,7 @@ typedef NS_ENUM(NSInteger, AWSHTTPMethod) {
 @property (nonatomic, strong) NSURL *uploadingFileURL;
 @property (nonatomic, strong) NSURL *downloadingFileURL;
 @property (nonatomic, assign) BOOL shouldWriteDirectly;
+@property (nonatomic, strong) NSNumber *downloadingFileOffset;
 
 @property (nonatomic, copy) AWSNetworkingUploadProgressBlock uploadProgress;
 @property (nonatomic, copy) AWSNetworkingDownloadProgressBlock downloadProgress;
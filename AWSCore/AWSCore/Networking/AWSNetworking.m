@@ -260,6 +260,7 @@ NSString *const AWSNetworkingErrorDomain = @"com.amazonaws.AWSNetworkingErrorDom
 
 @property (nonatomic, strong) AWSNetworkingRequest *internalRequest;
 @property (nonatomic, assign) NSNumber *shouldWriteDirectly;
+@property (nonatomic, strong) NSNumber *downloadingFileOffset;
 
 @end
 
@@ -44,9 +44,11 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
 @property (nonatomic, strong) NSError *error;
 @property (nonatomic, strong) id responseObject;
 @property (nonatomic, strong) NSMutableData *responseData;
+@property (nonatomic, strong) id<AWSHTTPURLResponseDecoder> responseDecoder;
 @property (nonatomic, strong) NSFileHandle *responseFilehandle;
 @property (nonatomic, strong) NSURL *tempDownloadedFileURL;
 @property (nonatomic, assign) BOOL shouldWriteDirectly;
+@property (nonatomic, strong) NSNumber *downloadingFileOffset;
 @property (nonatomic, assign) BOOL shouldWriteToFile;
 
 @property (atomic, assign) int64_t lastTotalLengthOfChunkSignatureSent;
@@ -78,6 +80,17 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
 
 //const int64_t AWSMinimumDownloadTaskSize = 1000000;
 
+/**
+ Spreads a retry delay over [interval / 2, interval] so that requests throttled at the same moment do not all come back at the same moment.
+ */
+static NSTimeInterval AWSURLSessionManagerJitteredTimeInterval(NSTimeInterval timeInterval) {
+    if (timeInterval <= 0) {
+        return 0;
+    }
+    double jitter = (double)arc4random_uniform(UINT32_MAX) / UINT32_MAX;
+    return timeInterval / 2 + timeInterval / 2 * jitter;
+}
+
 @interface AWSURLSessionManager()
 
 @property (nonatomic, strong) NSURLSession *session;
@@ -87,6 +100,60 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
 
 @implementation AWSURLSessionManager
 
+/**
+ In-flight credentials refreshes keyed by credentials provider. Shared by all session managers so that every request failing with the same expired credentials waits on a single refresh.
+ */
++ (NSMapTable *)refreshingCredentialsProviders {
+    static NSMapTable *_refreshingCredentialsProviders = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _refreshingCredentialsProviders = [[NSMapTable alloc] initWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality
+                                                                    valueOptions:NSPointerFunctionsStrongMemory
+                                                                        capacity:0];
+    });
+    return _refreshingCredentialsProviders;
+}
+
++ (AWSTask *)refreshCredentialsProvider:(id)credentialsProvider {
+    NSMapTable *refreshingCredentialsProviders = [self refreshingCredentialsProviders];
+    @synchronized(refreshingCredentialsProviders) {
+        AWSTask *refreshTask = [refreshingCredentialsProviders objectForKey:credentialsProvider];
+        if (refreshTask) {
+            return refreshTask;
+        }
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wundeclared-selector"
+        refreshTask = [[credentialsProvider performSelector:@selector(refresh)] continueWithBlock:^id(AWSTask *task) {
+            @synchronized(refreshingCredentialsProviders) {
+                [refreshingCredentialsProviders removeObjectForKey:credentialsProvider];
+            }
+            return task;
+        }];
+#pragma clang diagnostic pop
+
+        // A refresh that finished synchronously has already tried to remove itself.
+        if (!refreshTask.completed) {
+            [refreshingCredentialsProviders setObject:refreshTask forKey:credentialsProvider];
+        }
+        return refreshTask;
+    }
+}
+
++ (AWSTask *)refreshCredentialsForRequest:(AWSNetworkingRequest *)request {
+    id signer = [request.requestInterceptors lastObject];
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wundeclared-selector"
+    if ([signer respondsToSelector:@selector(credentialsProvider)]) {
+        id credentialsProvider = [signer performSelector:@selector(credentialsProvider)];
+        if ([credentialsProvider respondsToSelector:@selector(refresh)]) {
+            return [self refreshCredentialsProvider:credentialsProvider];
+        }
+    }
+#pragma clang diagnostic pop
+    return nil;
+}
+
 - (instancetype)init {
     @throw [NSException exceptionWithName:NSInternalInconsistencyException
                                    reason:@"`- init` is not a valid initializer. Use `- initWithConfiguration` instead."
@@ -128,6 +195,7 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
     delegate.downloadingFileURL = request.downloadingFileURL;
     delegate.uploadingFileURL = request.uploadingFileURL;
     delegate.shouldWriteDirectly = request.shouldWriteDirectly;
+    delegate.downloadingFileOffset = request.downloadingFileOffset;
     
     [self taskWithDelegate:delegate];
 }
@@ -135,6 +203,7 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
 - (void)taskWithDelegate:(AWSURLSessionManagerDelegate *)delegate {
     if (delegate.downloadingFileURL) delegate.shouldWriteToFile = YES;
     delegate.responseData = nil;
+    delegate.responseDecoder = nil;
     delegate.responseObject = nil;
     delegate.error = nil;
     NSMutableURLRequest *mutableRequest = [NSMutableURLRequest requestWithURL:delegate.request.URL];
@@ -171,7 +240,7 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
                      */
                     if ((!accessKey || !secretKey)
                         || [expiration compare:[NSDate dateWithTimeIntervalSinceNow:10 * 60]] == NSOrderedAscending) {
-                        return [credentialsProvider performSelector:@selector(refresh)];
+                        return [AWSURLSessionManager refreshCredentialsProvider:credentialsProvider];
                     }
                 }
             }
@@ -253,6 +322,24 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
     }];
 }
 
+- (void)retryTaskWithDelegate:(AWSURLSessionManagerDelegate *)delegate
+                afterInterval:(NSTimeInterval)timeInterval
+           credentialsRefresh:(AWSTask *)refreshTask {
+    delegate.currentRetryCount++;
+    int64_t delay = (int64_t)(AWSURLSessionManagerJitteredTimeInterval(timeInterval) * NSEC_PER_SEC);
+
+    // The retry is scheduled rather than slept on so that the session delegate queue keeps delivering other tasks' callbacks.
+    [(refreshTask ?: [AWSTask taskWithResult:nil]) continueWithBlock:^id(AWSTask *task) {
+        if (task.error) {
+            AWSLogError(@"Failed to refresh credentials before retrying: [%@]", task.error);
+        }
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, delay), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            [self taskWithDelegate:delegate];
+        });
+        return nil;
+    }];
+}
+
 #pragma mark - NSURLSessionTaskDelegate
 
 - (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)sessionTask didCompleteWithError:(NSError *)error {
@@ -316,10 +403,14 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
                 // need to call responseSerializer if there is no client-side error.
                 if ([delegate.request.responseSerializer respondsToSelector:@selector(responseObjectForResponse:originalRequest:currentRequest:data:error:)]) {
                     NSError *error = nil;
+                    id data = delegate.responseData;
+                    if (delegate.responseDecoder) {
+                        data = delegate.responseDecoder;
+                    }
                     delegate.responseObject = [delegate.request.responseSerializer responseObjectForResponse:httpResponse
                                                                                              originalRequest:sessionTask.originalRequest
                                                                                               currentRequest:sessionTask.currentRequest
-                                                                                                        data:delegate.responseData
+                                                                                                        data:data
                                                                                                        error:&error];
                     if (error) {
                         delegate.error = error;
@@ -338,6 +429,7 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
                                                                                  response:(NSHTTPURLResponse *)sessionTask.response
                                                                                      data:delegate.responseData
                                                                                     error:delegate.error];
+            AWSTask *credentialsRefreshTask = nil;
             switch (retryType) {
                 case AWSNetworkingRetryTypeShouldCorrectClockSkewAndRetry: {
                     //Correct Clock Skew
@@ -358,26 +450,17 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
                 }
                     
                 case AWSNetworkingRetryTypeShouldRefreshCredentialsAndRetry: {
-                    id signer = [delegate.request.requestInterceptors lastObject];
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wundeclared-selector"
-                    if ([signer respondsToSelector:@selector(credentialsProvider)]) {
-                        id credentialsProvider = [signer performSelector:@selector(credentialsProvider)];
-                        if ([credentialsProvider respondsToSelector:@selector(refresh)]) {
-                            [[credentialsProvider performSelector:@selector(refresh)] waitUntilFinished];
-                        }
-                    }
-#pragma clang diagnostic pop
+                    credentialsRefreshTask = [AWSURLSessionManager refreshCredentialsForRequest:delegate.request];
                 }
                     
                 case AWSNetworkingRetryTypeShouldRetry: {
-                    NSTimeInterval timeIntervalToSleep = [delegate.request.retryHandler timeIntervalForRetry:delegate.currentRetryCount
-                                                                                                    response:(NSHTTPURLResponse *)sessionTask.response
-                                                                                                        data:delegate.responseData
-                                                                                                       error:delegate.error];
-                    [NSThread sleepForTimeInterval:timeIntervalToSleep];
-                    delegate.currentRetryCount++;
-                    [self taskWithDelegate:delegate];
+                    NSTimeInterval timeIntervalForRetry = [delegate.request.retryHandler timeIntervalForRetry:delegate.currentRetryCount
+                                                                                                     response:(NSHTTPURLResponse *)sessionTask.response
+                                                                                                         data:delegate.responseData
+                                                                                                        error:delegate.error];
+                    [self retryTaskWithDelegate:delegate
+                                  afterInterval:timeIntervalForRetry
+                             credentialsRefresh:credentialsRefreshTask];
                 }
                     break;
                     
@@ -460,7 +543,16 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
                         Original file may be modified even the downloading task has been paused/cancelled later.");
             
             NSError *error = nil;
-            if ([[NSFileManager defaultManager] fileExistsAtPath:delegate.downloadingFileURL.path]) {
+            if (delegate.downloadingFileOffset && [[NSFileManager defaultManager] fileExistsAtPath:delegate.downloadingFileURL.path]) {
+                //If downloadingFileOffset is set (e.g. a byte range of a preallocated file), downloaded data will be wrote starting at that offset instead.
+                AWSLogDebug(@"target file already exists, will be wrote at offset %@ of the file path: %@",delegate.downloadingFileOffset,delegate.downloadingFileURL);
+                delegate.responseFilehandle = [NSFileHandle fileHandleForUpdatingURL:delegate.downloadingFileURL error:&error];
+                if (error) {
+                    AWSLogError(@"Error: [%@]", error);
+                }
+                [delegate.responseFilehandle seekToFileOffset:[delegate.downloadingFileOffset unsignedLongLongValue]];
+
+            } else if ([[NSFileManager defaultManager] fileExistsAtPath:delegate.downloadingFileURL.path]) {
                 AWSLogDebug(@"target file already exists, will be appended at the file path: %@",delegate.downloadingFileURL);
                 delegate.responseFilehandle = [NSFileHandle fileHandleForUpdatingURL:delegate.downloadingFileURL error:&error];
                 if (error) {
@@ -513,6 +605,15 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
         
     }
     
+    //If the response serializer can decode the body while it arrives, no intermediate object graph is built from it.
+    //The raw body is still kept, so that the retry handler sees it when a successful status carries an error.
+    delegate.responseDecoder = nil;
+    if (!delegate.shouldWriteToFile
+        && [response isKindOfClass:[NSHTTPURLResponse class]]
+        && [delegate.request.responseSerializer respondsToSelector:@selector(responseDecoderForResponse:)]) {
+        delegate.responseDecoder = [delegate.request.responseSerializer responseDecoderForResponse:(NSHTTPURLResponse *)response];
+    }
+
     //    if([response isKindOfClass:[NSHTTPURLResponse class]]) {
     //        NSHTTPURLResponse *httpResponse = (NSHTTPURLResponse *)response;
     //        if ([[[httpResponse allHeaderFields] objectForKey:@"Content-Length"] longLongValue] >= AWSMinimumDownloadTaskSize) {
@@ -530,6 +631,7 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
     if (delegate.responseFilehandle) {
         [delegate.responseFilehandle writeData:data];
     } else {
+        [delegate.responseDecoder appendData:data];
         if (!delegate.responseData) {
             delegate.responseData = [NSMutableData dataWithData:data];
         } else if ([delegate.responseData isKindOfClass:[NSMutableData class]]) {
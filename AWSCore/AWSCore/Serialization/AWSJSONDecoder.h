@@ -0,0 +1,49 @@
+/*
+ Copyright 2010-2015 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License").
+ You may not use this file except in compliance with the License.
+ A copy of the License is located at
+
+ http://aws.amazon.com/apache2.0
+
+ or in the "license" file accompanying this file. This file is distributed
+ on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ express or implied. See the License for the specific language governing
+ permissions and limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+#import "AWSNetworking.h"
+
+@class AWSShape;
+
+/**
+ Builds the output model of an operation from its JSON response in a single pass, guided by the compiled shape of the
+ output. The body can be appended in pieces as it arrives, and each piece is decoded right away. It produces the same
+ model as `AWSJSONParser` followed by `AWSMTLJSONAdapter`, without building the dictionaries in between.
+ */
+@interface AWSJSONDecoder : NSObject <AWSHTTPURLResponseDecoder>
+
+/**
+ Returns whether responses of the given output shape can be decoded into models of the given class.
+ */
++ (BOOL)canDecodeShape:(AWSShape *)shape
+            modelClass:(Class)modelClass;
+
+- (instancetype)initWithShape:(AWSShape *)shape
+                   modelClass:(Class)modelClass;
+
+/**
+ Decodes the next piece of the body. Once the body is found to be invalid, the rest of it is ignored.
+ */
+- (void)appendData:(NSData *)data;
+
+/**
+ Returns the model decoded from the whole body.
+ @param error On failure, an error in `NSCocoaErrorDomain` when the body is not valid JSON, or in
+              `AWSJSONParserErrorDomain` when it does not match the shape.
+ */
+- (id)decodedModelWithError:(NSError *__autoreleasing *)error;
+
+@end
@@ -0,0 +1,675 @@
+/*
+ Copyright 2010-2015 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License").
+ You may not use this file except in compliance with the License.
+ A copy of the License is located at
+
+ http://aws.amazon.com/apache2.0
+
+ or in the "license" file accompanying this file. This file is distributed
+ on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ express or implied. See the License for the specific language governing
+ permissions and limitations under the License.
+ */
+
+#import "AWSJSONDecoder.h"
+
+#import "AWSMantle.h"
+#import "AWSCategory.h"
+#import "AWSSerialization.h"
+#import "AWSServiceModel.h"
+#import "AWSJSONModelMetadata.h"
+
+typedef NS_ENUM(NSInteger, AWSJSONDecoderState) {
+    AWSJSONDecoderStateBetweenTokens,
+    AWSJSONDecoderStateString,
+    AWSJSONDecoderStateNumber,
+    AWSJSONDecoderStateLiteral,
+};
+
+typedef NS_ENUM(NSInteger, AWSJSONDecoderExpectation) {
+    AWSJSONDecoderExpectValue,
+    AWSJSONDecoderExpectValueOrEnd,
+    AWSJSONDecoderExpectKey,
+    AWSJSONDecoderExpectKeyOrEnd,
+    AWSJSONDecoderExpectColon,
+    AWSJSONDecoderExpectSeparatorOrEnd,
+    AWSJSONDecoderExpectNothing,
+};
+
+// An object or array being decoded. A frame without a shape is read through and dropped.
+@interface AWSJSONDecoderFrame : NSObject
+
+@property (nonatomic, assign, getter=isObject) BOOL object;
+@property (nonatomic, strong) AWSShape *shape;
+@property (nonatomic, strong) AWSJSONModelMetadata *metadata;
+// The property values of a structure, or the entries of a map.
+@property (nonatomic, strong) NSMutableDictionary *values;
+@property (nonatomic, strong) NSMutableArray *elements;
+@property (nonatomic, strong) NSString *key;
+@property (nonatomic, strong) AWSShapeMember *member;
+@property (nonatomic, strong) NSString *propertyKey;
+
+@end
+
+@implementation AWSJSONDecoderFrame
+
+@end
+
+static BOOL AWSJSONDecoderIsNumberCharacter(uint8_t c) {
+    return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+}
+
+static BOOL AWSJSONDecoderIsLiteralCharacter(uint8_t c) {
+    return c >= 'a' && c <= 'z';
+}
+
+static BOOL AWSJSONDecoderReadHex4(const uint8_t *bytes, uint32_t *value) {
+    uint32_t result = 0;
+    for (NSUInteger i = 0; i < 4; i++) {
+        uint8_t c = bytes[i];
+        result <<= 4;
+        if (c >= '0' && c <= '9') {
+            result |= c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            result |= c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            result |= c - 'A' + 10;
+        } else {
+            return NO;
+        }
+    }
+    *value = result;
+    return YES;
+}
+
+static void AWSJSONDecoderAppendCodePoint(NSMutableData *data, uint32_t codePoint) {
+    uint8_t buffer[4];
+    NSUInteger length = 0;
+    if (codePoint < 0x80) {
+        buffer[length++] = codePoint;
+    } else if (codePoint < 0x800) {
+        buffer[length++] = 0xC0 | (codePoint >> 6);
+        buffer[length++] = 0x80 | (codePoint & 0x3F);
+    } else if (codePoint < 0x10000) {
+        buffer[length++] = 0xE0 | (codePoint >> 12);
+        buffer[length++] = 0x80 | ((codePoint >> 6) & 0x3F);
+        buffer[length++] = 0x80 | (codePoint & 0x3F);
+    } else {
+        buffer[length++] = 0xF0 | (codePoint >> 18);
+        buffer[length++] = 0x80 | ((codePoint >> 12) & 0x3F);
+        buffer[length++] = 0x80 | ((codePoint >> 6) & 0x3F);
+        buffer[length++] = 0x80 | (codePoint & 0x3F);
+    }
+    [data appendBytes:buffer length:length];
+}
+
+// Returns the string of the bytes between the quotes of a JSON string with escapes in it, or nil if an escape is invalid.
+static NSString *AWSJSONDecoderUnescapedString(const uint8_t *bytes, NSUInteger length) {
+    NSMutableData *data = [NSMutableData dataWithCapacity:length];
+    NSUInteger runStart = 0;
+    NSUInteger i = 0;
+    while (i < length) {
+        if (bytes[i] != '\\') {
+            i++;
+            continue;
+        }
+        [data appendBytes:bytes + runStart length:i - runStart];
+        if (i + 1 >= length) {
+            return nil;
+        }
+        uint8_t c = bytes[i + 1];
+        i += 2;
+        switch (c) {
+            case '"':
+            case '\\':
+            case '/':
+                [data appendBytes:&c length:1];
+                break;
+            case 'b':
+                AWSJSONDecoderAppendCodePoint(data, '\b');
+                break;
+            case 'f':
+                AWSJSONDecoderAppendCodePoint(data, '\f');
+                break;
+            case 'n':
+                AWSJSONDecoderAppendCodePoint(data, '\n');
+                break;
+            case 'r':
+                AWSJSONDecoderAppendCodePoint(data, '\r');
+                break;
+            case 't':
+                AWSJSONDecoderAppendCodePoint(data, '\t');
+                break;
+            case 'u': {
+                uint32_t codePoint = 0;
+                if (i + 4 > length || !AWSJSONDecoderReadHex4(bytes + i, &codePoint)) {
+                    return nil;
+                }
+                i += 4;
+                if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+                    uint32_t lowSurrogate = 0;
+                    if (i + 6 <= length && bytes[i] == '\\' && bytes[i + 1] == 'u'
+                        && AWSJSONDecoderReadHex4(bytes + i + 2, &lowSurrogate)
+                        && lowSurrogate >= 0xDC00 && lowSurrogate <= 0xDFFF) {
+                        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+                        i += 6;
+                    } else {
+                        codePoint = 0xFFFD;
+                    }
+                } else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF) {
+                    codePoint = 0xFFFD;
+                }
+                AWSJSONDecoderAppendCodePoint(data, codePoint);
+                break;
+            }
+            default:
+                return nil;
+        }
+        runStart = i;
+    }
+    [data appendBytes:bytes + runStart length:length - runStart];
+    return [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+}
+
+// Reads a number the way NSJSONSerialization does: integers stay integers unless they do not fit in 64 bits.
+static NSNumber *AWSJSONDecoderNumber(NSMutableData *tokenData) {
+    [tokenData appendBytes:"" length:1];
+    const char *string = [tokenData bytes];
+    char *end = NULL;
+
+    if (!strpbrk(string, ".eE")) {
+        errno = 0;
+        long long value = strtoll(string, &end, 10);
+        if (errno == 0 && end != string && *end == '\0') {
+            return @(value);
+        }
+        if (errno == ERANGE && string[0] != '-') {
+            errno = 0;
+            unsigned long long unsignedValue = strtoull(string, &end, 10);
+            if (errno == 0 && end != string && *end == '\0') {
+                return @(unsignedValue);
+            }
+        }
+    }
+
+    double value = strtod(string, &end);
+    if (end == string || *end != '\0' || isinf(value)) {
+        return nil;
+    }
+    return @(value);
+}
+
+@interface AWSJSONDecoder()
+
+@property (nonatomic, strong) AWSShape *shape;
+@property (nonatomic, assign) Class modelClass;
+@property (nonatomic, strong) AWSJSONModelShapeMapping *mapping;
+@property (nonatomic, strong) NSMutableArray *frames;
+@property (nonatomic, strong) NSMutableData *tokenData;
+@property (nonatomic, assign) AWSJSONDecoderState state;
+@property (nonatomic, assign) AWSJSONDecoderExpectation expectation;
+@property (nonatomic, assign) BOOL tokenHasEscapes;
+@property (nonatomic, assign) BOOL escapePending;
+@property (nonatomic, assign) NSUInteger decodedLength;
+@property (nonatomic, strong) id rootValue;
+@property (nonatomic, strong) NSError *error;
+
+@end
+
+@implementation AWSJSONDecoder
+
++ (BOOL)canDecodeShape:(AWSShape *)shape
+            modelClass:(Class)modelClass {
+    if (shape.type != AWSShapeTypeStructure || shape.payloadMemberName) {
+        return NO;
+    }
+    for (AWSShapeMember *member in shape.members) {
+        if (member.location != AWSShapeMemberLocationBody) {
+            return NO;
+        }
+    }
+    return [AWSJSONModelShapeMapping mappingForShape:shape modelClass:modelClass] != nil;
+}
+
+- (instancetype)initWithShape:(AWSShape *)shape
+                   modelClass:(Class)modelClass {
+    if (self = [super init]) {
+        _mapping = [AWSJSONModelShapeMapping mappingForShape:shape modelClass:modelClass];
+        if (!_mapping) {
+            return nil;
+        }
+        _shape = shape;
+        _modelClass = modelClass;
+        _frames = [NSMutableArray new];
+        _tokenData = [NSMutableData new];
+        _state = AWSJSONDecoderStateBetweenTokens;
+        _expectation = AWSJSONDecoderExpectValue;
+    }
+    return self;
+}
+
+#pragma mark - Errors
+
+- (BOOL)failWithCode:(NSInteger)code description:(NSString *)description {
+    self.error = [NSError errorWithDomain:AWSJSONParserErrorDomain
+                                     code:code
+                                 userInfo:@{NSLocalizedDescriptionKey : description}];
+    return NO;
+}
+
+- (BOOL)failWithSyntaxErrorAtOffset:(NSUInteger)offset {
+    // The same error as NSJSONSerialization gives for data that is not valid JSON.
+    self.error = [NSError errorWithDomain:NSCocoaErrorDomain
+                                     code:NSPropertyListReadCorruptError
+                                 userInfo:@{NSLocalizedDescriptionKey : [NSString stringWithFormat:@"Invalid JSON around byte %lu.", (unsigned long)offset]}];
+    return NO;
+}
+
+#pragma mark - Decoding
+
+- (void)appendData:(NSData *)data {
+    [data enumerateByteRangesUsingBlock:^(const void *bytes, NSRange byteRange, BOOL *stop) {
+        if (![self decodeBytes:bytes length:byteRange.length]) {
+            *stop = YES;
+        }
+    }];
+}
+
+- (BOOL)decodeBytes:(const uint8_t *)bytes length:(NSUInteger)length {
+    if (self.error) {
+        return NO;
+    }
+
+    NSUInteger i = 0;
+    while (i < length) {
+        switch (self.state) {
+            case AWSJSONDecoderStateString: {
+                // Copies everything up to the closing quote at once. Escapes are resolved when the string ends.
+                NSUInteger start = i;
+                BOOL escapePending = self.escapePending;
+                while (i < length) {
+                    uint8_t c = bytes[i];
+                    if (escapePending) {
+                        escapePending = NO;
+                    } else if (c == '\\') {
+                        escapePending = YES;
+                        self.tokenHasEscapes = YES;
+                    } else if (c == '"') {
+                        break;
+                    }
+                    i++;
+                }
+                self.escapePending = escapePending;
+                [self.tokenData appendBytes:bytes + start length:i - start];
+                if (i < length) {
+                    i++;
+                    self.state = AWSJSONDecoderStateBetweenTokens;
+                    if (![self endString]) {
+                        return [self failAtOffset:self.decodedLength + i];
+                    }
+                }
+                break;
+            }
+
+            case AWSJSONDecoderStateNumber:
+            case AWSJSONDecoderStateLiteral: {
+                NSUInteger start = i;
+                BOOL isNumber = self.state == AWSJSONDecoderStateNumber;
+                while (i < length && (isNumber ? AWSJSONDecoderIsNumberCharacter(bytes[i]) : AWSJSONDecoderIsLiteralCharacter(bytes[i]))) {
+                    i++;
+                }
+                [self.tokenData appendBytes:bytes + start length:i - start];
+                if (i < length) {
+                    self.state = AWSJSONDecoderStateBetweenTokens;
+                    if (!(isNumber ? [self endNumber] : [self endLiteral])) {
+                        return [self failAtOffset:self.decodedLength + i];
+                    }
+                }
+                break;
+            }
+
+            case AWSJSONDecoderStateBetweenTokens: {
+                uint8_t c = bytes[i];
+                BOOL succeeded = YES;
+                switch (c) {
+                    case ' ':
+                    case '\t':
+                    case '\n':
+                    case '\r':
+                        break;
+                    case '{':
+                    case '[':
+                        succeeded = [self beginContainer:c == '{'];
+                        break;
+                    case '}':
+                    case ']':
+                        succeeded = [self endContainer:c == '}'];
+                        break;
+                    case ',':
+                        succeeded = [self separator];
+                        break;
+                    case ':':
+                        succeeded = self.expectation == AWSJSONDecoderExpectColon;
+                        self.expectation = AWSJSONDecoderExpectValue;
+                        break;
+                    case '"':
+                        succeeded = [self isExpectingValue] || [self isExpectingKey];
+                        self.state = AWSJSONDecoderStateString;
+                        self.tokenHasEscapes = NO;
+                        [self.tokenData setLength:0];
+                        break;
+                    default:
+                        if (![self isExpectingValue]) {
+                            succeeded = NO;
+                        } else if (AWSJSONDecoderIsNumberCharacter(c)) {
+                            self.state = AWSJSONDecoderStateNumber;
+                        } else if (AWSJSONDecoderIsLiteralCharacter(c)) {
+                            self.state = AWSJSONDecoderStateLiteral;
+                        } else {
+                            succeeded = NO;
+                        }
+                        [self.tokenData setLength:0];
+                        // The first character is read again as part of the token.
+                        if (succeeded) {
+                            continue;
+                        }
+                        break;
+                }
+                if (!succeeded) {
+                    return [self failAtOffset:self.decodedLength + i];
+                }
+                i++;
+                break;
+            }
+        }
+    }
+
+    self.decodedLength += length;
+    return YES;
+}
+
+- (BOOL)failAtOffset:(NSUInteger)offset {
+    if (!self.error) {
+        [self failWithSyntaxErrorAtOffset:offset];
+    }
+    return NO;
+}
+
+- (BOOL)isExpectingValue {
+    return self.expectation == AWSJSONDecoderExpectValue || self.expectation == AWSJSONDecoderExpectValueOrEnd;
+}
+
+- (BOOL)isExpectingKey {
+    return self.expectation == AWSJSONDecoderExpectKey || self.expectation == AWSJSONDecoderExpectKeyOrEnd;
+}
+
+// The shape of the value about to be decoded, or nil if the value is to be dropped.
+- (AWSShape *)shapeForNextValue {
+    AWSJSONDecoderFrame *frame = [self.frames lastObject];
+    if (!frame) {
+        return self.shape;
+    }
+    switch (frame.shape.type) {
+        case AWSShapeTypeStructure:
+            return frame.propertyKey ? frame.member.shape : nil;
+        case AWSShapeTypeList:
+            return frame.shape.listMember.shape;
+        case AWSShapeTypeMap:
+            return frame.shape.mapValue.shape;
+        default:
+            return nil;
+    }
+}
+
+- (BOOL)beginContainer:(BOOL)isObject {
+    if (![self isExpectingValue]) {
+        return NO;
+    }
+
+    AWSJSONDecoderFrame *frame = [AWSJSONDecoderFrame new];
+    frame.object = isObject;
+    AWSShape *shape = [self shapeForNextValue];
+    switch (shape.type) {
+        case AWSShapeTypeStructure:
+            if (!isObject) {
+                return [self failWithCode:AWSJSONParserInvalidParameter description:@"a structure input should be a dictionary but got an array"];
+            }
+            frame.metadata = [self.mapping metadataForShape:shape];
+            frame.values = [NSMutableDictionary new];
+            break;
+        case AWSShapeTypeMap:
+            if (!isObject) {
+                return [self failWithCode:AWSJSONParserInvalidParameter description:@"a map input should be a dictionary but got an array"];
+            }
+            frame.values = [NSMutableDictionary new];
+            break;
+        case AWSShapeTypeList:
+            if (isObject) {
+                return [self failWithCode:AWSJSONParserInvalidParameter description:@"a list input should be an array but got a dictionary"];
+            }
+            frame.elements = [NSMutableArray new];
+            break;
+        default:
+            // Members the model has no property for, and objects where a scalar was expected, are dropped.
+            shape = nil;
+            break;
+    }
+    frame.shape = shape;
+    [self.frames addObject:frame];
+    self.expectation = isObject ? AWSJSONDecoderExpectKeyOrEnd : AWSJSONDecoderExpectValueOrEnd;
+    return YES;
+}
+
+- (BOOL)endContainer:(BOOL)isObject {
+    AWSJSONDecoderFrame *frame = [self.frames lastObject];
+    if (!frame || frame.isObject != isObject) {
+        return NO;
+    }
+    if (self.expectation != AWSJSONDecoderExpectSeparatorOrEnd
+        && self.expectation != (isObject ? AWSJSONDecoderExpectKeyOrEnd : AWSJSONDecoderExpectValueOrEnd)) {
+        return NO;
+    }
+    [self.frames removeLastObject];
+
+    id value = nil;
+    switch (frame.shape.type) {
+        case AWSShapeTypeStructure: {
+            NSError *error = nil;
+            value = [frame.metadata.modelClass modelWithDictionary:frame.values error:&error];
+            if (!value) {
+                if (error) {
+                    self.error = error;
+                    return NO;
+                }
+                return [self failWithCode:AWSJSONParserInternalError
+                              description:[NSString stringWithFormat:@"%@ could not be created from the response", frame.metadata.modelClass]];
+            }
+            break;
+        }
+        case AWSShapeTypeMap:
+            value = frame.values;
+            break;
+        case AWSShapeTypeList:
+            value = frame.elements;
+            break;
+        default:
+            break;
+    }
+    return [self endValue:value];
+}
+
+- (BOOL)separator {
+    AWSJSONDecoderFrame *frame = [self.frames lastObject];
+    if (!frame || self.expectation != AWSJSONDecoderExpectSeparatorOrEnd) {
+        return NO;
+    }
+    self.expectation = frame.isObject ? AWSJSONDecoderExpectKey : AWSJSONDecoderExpectValue;
+    return YES;
+}
+
+- (BOOL)endString {
+    AWSJSONDecoderFrame *frame = [self.frames lastObject];
+    BOOL isKey = [self isExpectingKey];
+    // Strings that end up dropped are never created.
+    if (frame && !frame.shape) {
+        if (isKey) {
+            self.expectation = AWSJSONDecoderExpectColon;
+            return YES;
+        }
+        return [self endValue:nil];
+    }
+    if (!isKey && frame.shape.type == AWSShapeTypeStructure && !frame.propertyKey) {
+        return [self endValue:nil];
+    }
+
+    NSString *string = nil;
+    if (self.tokenHasEscapes) {
+        string = AWSJSONDecoderUnescapedString([self.tokenData bytes], [self.tokenData length]);
+    } else {
+        string = [[NSString alloc] initWithData:self.tokenData encoding:NSUTF8StringEncoding];
+    }
+    if (!string) {
+        return NO;
+    }
+
+    if (isKey) {
+        frame.key = string;
+        if (frame.shape.type == AWSShapeTypeStructure) {
+            // The same lookup as AWSJSONParser.
+            AWSShapeMember *member = [frame.shape memberWithLocationName:string] ?: [frame.shape memberNamed:string];
+            frame.member = member;
+            frame.propertyKey = member ? frame.metadata.propertyKeysByJSONKey[member.name] : nil;
+        }
+        self.expectation = AWSJSONDecoderExpectColon;
+        return YES;
+    }
+    return [self endScalar:string];
+}
+
+- (BOOL)endNumber {
+    NSNumber *number = AWSJSONDecoderNumber(self.tokenData);
+    if (!number) {
+        return NO;
+    }
+    return [self endScalar:number];
+}
+
+- (BOOL)endLiteral {
+    NSUInteger length = [self.tokenData length];
+    const char *literal = [self.tokenData bytes];
+    if (length == 4 && memcmp(literal, "true", 4) == 0) {
+        return [self endScalar:@YES];
+    } else if (length == 5 && memcmp(literal, "false", 5) == 0) {
+        return [self endScalar:@NO];
+    } else if (length == 4 && memcmp(literal, "null", 4) == 0) {
+        return [self endScalar:[NSNull null]];
+    }
+    return NO;
+}
+
+// Converts a scalar as -[AWSJSONParser serializeShape:value:target:error:] does.
+- (BOOL)endScalar:(id)value {
+    AWSShape *shape = [self shapeForNextValue];
+    if (shape && value != [NSNull null]) {
+        switch (shape.type) {
+            case AWSShapeTypeStructure:
+                return [self failWithCode:AWSJSONParserInvalidParameter description:[NSString stringWithFormat:@"a structure input should be a dictionary but got:%@", value]];
+            case AWSShapeTypeList:
+                return [self failWithCode:AWSJSONParserInvalidParameter description:[NSString stringWithFormat:@"a list input should be an array but got:%@", value]];
+            case AWSShapeTypeMap:
+                return [self failWithCode:AWSJSONParserInvalidParameter description:[NSString stringWithFormat:@"a map input should be a dictionary but got:%@", value]];
+            case AWSShapeTypeTimestamp: {
+                NSDate *timeStampDate = nil;
+                if ([value isKindOfClass:[NSString class]]) {
+                    timeStampDate = [NSDate aws_dateFromString:value];
+                }
+                value = timeStampDate ? @([timeStampDate timeIntervalSince1970]) : @([value doubleValue]);
+                break;
+            }
+            case AWSShapeTypeBlob:
+                if (![value isKindOfClass:[NSString class]]) {
+                    return [self failWithCode:AWSJSONParserInvalidParameter description:@"blob value should be NSString type."];
+                }
+                value = [[NSData alloc] initWithBase64EncodedString:value options:0] ?: value;
+                break;
+            default:
+                break;
+        }
+    }
+    return [self endValue:value];
+}
+
+- (BOOL)endValue:(id)value {
+    AWSJSONDecoderFrame *frame = [self.frames lastObject];
+    if (!frame) {
+        self.rootValue = value;
+        self.expectation = AWSJSONDecoderExpectNothing;
+        return YES;
+    }
+
+    self.expectation = AWSJSONDecoderExpectSeparatorOrEnd;
+    if (!value) {
+        return YES;
+    }
+    switch (frame.shape.type) {
+        case AWSShapeTypeStructure: {
+            if (!frame.propertyKey || value == [NSNull null]) {
+                break;
+            }
+            // Models nested at any depth were built above, so only the transformers of other values are applied,
+            // as AWSMTLJSONAdapter would.
+            AWSShape *memberShape = frame.member.shape;
+            NSValueTransformer *transformer = frame.metadata.transformersByPropertyKey[frame.propertyKey];
+            if (transformer
+                && memberShape.type != AWSShapeTypeStructure
+                && ![self.mapping shapeHoldsModels:memberShape]) {
+                value = [transformer transformedValue:value] ?: [NSNull null];
+            }
+            frame.values[frame.propertyKey] = value;
+            break;
+        }
+        case AWSShapeTypeList:
+            [frame.elements addObject:value];
+            break;
+        case AWSShapeTypeMap:
+            frame.values[frame.key] = value;
+            break;
+        default:
+            break;
+    }
+    return YES;
+}
+
+- (id)decodedModelWithError:(NSError *__autoreleasing *)error {
+    if (!self.error) {
+        if (self.state == AWSJSONDecoderStateNumber || self.state == AWSJSONDecoderStateLiteral) {
+            // A value at the end of the body has nothing after it to end it.
+            BOOL isNumber = self.state == AWSJSONDecoderStateNumber;
+            self.state = AWSJSONDecoderStateBetweenTokens;
+            if (!(isNumber ? [self endNumber] : [self endLiteral])) {
+                [self failAtOffset:self.decodedLength];
+            }
+        } else if (self.state == AWSJSONDecoderStateString || [self.frames count] > 0) {
+            [self failAtOffset:self.decodedLength];
+        }
+    }
+
+    if (!self.error && (!self.rootValue || self.rootValue == [NSNull null])) {
+        // An empty body makes an empty model, as with AWSJSONParser.
+        NSError *modelError = nil;
+        self.rootValue = [self.modelClass modelWithDictionary:@{} error:&modelError];
+        self.error = modelError;
+    }
+
+    if (self.error) {
+        if (error) {
+            *error = self.error;
+        }
+        return nil;
+    }
+    return self.rootValue;
+}
+
+@end
@@ -0,0 +1,45 @@
+/*
+ Copyright 2010-2015 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License").
+ You may not use this file except in compliance with the License.
+ A copy of the License is located at
+
+ http://aws.amazon.com/apache2.0
+
+ or in the "license" file accompanying this file. This file is distributed
+ on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ express or implied. See the License for the specific language governing
+ permissions and limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class AWSShape;
+@class AWSMTLModel;
+@protocol AWSMTLJSONSerializing;
+
+/**
+ Writes the JSON body of a request straight from its model object, guided by the compiled shape of the operation
+ input. It produces the same JSON as `AWSMTLJSONAdapter` followed by `AWSJSONBuilder`, without building their
+ intermediate dictionaries.
+ */
+@interface AWSJSONEncoder : NSObject
+
+/**
+ Returns whether the body of the given input shape holds every member, so that a request can be sent from the JSON
+ written by this class alone.
+ */
++ (BOOL)canEncodeShape:(AWSShape *)shape;
+
+/**
+ Returns the UTF-8 JSON of the members of the model located in the body.
+ @param model The request model.
+ @param shape The input shape of the operation.
+ @param error On failure, an error in `AWSJSONBuilderErrorDomain`.
+ */
++ (NSData *)JSONDataForModel:(AWSMTLModel<AWSMTLJSONSerializing> *)model
+                       shape:(AWSShape *)shape
+                       error:(NSError *__autoreleasing *)error;
+
+@end
@@ -0,0 +1,419 @@
+/*
+ Copyright 2010-2015 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License").
+ You may not use this file except in compliance with the License.
+ A copy of the License is located at
+
+ http://aws.amazon.com/apache2.0
+
+ or in the "license" file accompanying this file. This file is distributed
+ on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ express or implied. See the License for the specific language governing
+ permissions and limitations under the License.
+ */
+
+#import "AWSJSONEncoder.h"
+
+#import "AWSMantle.h"
+#import "AWSCategory.h"
+#import "AWSSerialization.h"
+#import "AWSServiceModel.h"
+#import "AWSJSONModelMetadata.h"
+
+static void AWSJSONEncoderAppend(NSMutableData *data, const char *string) {
+    [data appendBytes:string length:strlen(string)];
+}
+
+static void AWSJSONEncoderAppendEscapedBytes(NSMutableData *data, const uint8_t *bytes, NSUInteger length) {
+    static const char hexDigits[] = "0123456789abcdef";
+    NSUInteger runStart = 0;
+    for (NSUInteger i = 0; i < length; i++) {
+        uint8_t c = bytes[i];
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        [data appendBytes:bytes + runStart length:i - runStart];
+        switch (c) {
+            case '"':
+                AWSJSONEncoderAppend(data, "\\\"");
+                break;
+            case '\\':
+                AWSJSONEncoderAppend(data, "\\\\");
+                break;
+            case '\n':
+                AWSJSONEncoderAppend(data, "\\n");
+                break;
+            case '\r':
+                AWSJSONEncoderAppend(data, "\\r");
+                break;
+            case '\t':
+                AWSJSONEncoderAppend(data, "\\t");
+                break;
+            default: {
+                char escape[] = {'\\', 'u', '0', '0', hexDigits[c >> 4], hexDigits[c & 0xF]};
+                [data appendBytes:escape length:sizeof(escape)];
+                break;
+            }
+        }
+        runStart = i + 1;
+    }
+    [data appendBytes:bytes + runStart length:length - runStart];
+}
+
+static void AWSJSONEncoderAppendString(NSMutableData *data, NSString *string) {
+    AWSJSONEncoderAppend(data, "\"");
+    // Converts the string in chunks through a stack buffer rather than asking for a whole UTF-8 copy of it.
+    uint8_t buffer[1024];
+    NSRange remainingRange = NSMakeRange(0, [string length]);
+    while (remainingRange.length > 0) {
+        NSUInteger usedLength = 0;
+        if (![string getBytes:buffer
+                    maxLength:sizeof(buffer)
+                   usedLength:&usedLength
+                     encoding:NSUTF8StringEncoding
+                      options:NSStringEncodingConversionAllowLossy
+                        range:remainingRange
+               remainingRange:&remainingRange]) {
+            break;
+        }
+        AWSJSONEncoderAppendEscapedBytes(data, buffer, usedLength);
+    }
+    AWSJSONEncoderAppend(data, "\"");
+}
+
+static BOOL AWSJSONEncoderAppendNumber(NSMutableData *data, NSNumber *number, BOOL floatingPoint) {
+    char buffer[32];
+    const char *objCType = [number objCType];
+    if (floatingPoint || strcmp(objCType, @encode(double)) == 0 || strcmp(objCType, @encode(float)) == 0) {
+        double value = [number doubleValue];
+        if (isnan(value) || isinf(value)) {
+            return NO;
+        }
+        // The shortest of the two precisions that reads back as the same double.
+        snprintf(buffer, sizeof(buffer), "%.15g", value);
+        if (strtod(buffer, NULL) != value) {
+            snprintf(buffer, sizeof(buffer), "%.17g", value);
+        }
+    } else if (strcmp(objCType, @encode(unsigned long long)) == 0) {
+        snprintf(buffer, sizeof(buffer), "%llu", [number unsignedLongLongValue]);
+    } else {
+        snprintf(buffer, sizeof(buffer), "%lld", [number longLongValue]);
+    }
+    AWSJSONEncoderAppend(data, buffer);
+    return YES;
+}
+
+static BOOL AWSJSONEncoderIsBoolean(NSNumber *number) {
+    return CFGetTypeID((__bridge CFTypeRef)number) == CFBooleanGetTypeID();
+}
+
+@interface AWSJSONEncoder()
+
+@property (nonatomic, strong) NSMutableData *data;
+@property (nonatomic, strong) NSError *error;
+// Saves a trip through the locked global cache for every nested model of the same class.
+@property (nonatomic, strong) NSMutableDictionary *metadataByClass;
+
+@end
+
+@implementation AWSJSONEncoder
+
++ (BOOL)canEncodeShape:(AWSShape *)shape {
+    if (shape.type != AWSShapeTypeStructure || shape.payloadMemberName) {
+        return NO;
+    }
+    for (AWSShapeMember *member in shape.members) {
+        if (member.location != AWSShapeMemberLocationBody || member.streaming) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
++ (NSData *)JSONDataForModel:(AWSMTLModel<AWSMTLJSONSerializing> *)model
+                       shape:(AWSShape *)shape
+                       error:(NSError *__autoreleasing *)error {
+    AWSJSONEncoder *encoder = [AWSJSONEncoder new];
+    encoder.data = [NSMutableData dataWithCapacity:256];
+    encoder.metadataByClass = [NSMutableDictionary new];
+
+    if (![encoder appendModel:model shape:shape]) {
+        if (error) {
+            *error = encoder.error;
+        }
+        return nil;
+    }
+    return encoder.data;
+}
+
+- (BOOL)failWithDescription:(NSString *)description {
+    self.error = [NSError errorWithDomain:AWSJSONBuilderErrorDomain
+                                     code:AWSJSONBuilderInvalidParameter
+                                 userInfo:@{NSLocalizedDescriptionKey : description}];
+    return NO;
+}
+
+- (AWSJSONModelMetadata *)metadataForClass:(Class)modelClass {
+    AWSJSONModelMetadata *metadata = self.metadataByClass[(id<NSCopying>)modelClass];
+    if (!metadata) {
+        metadata = [AWSJSONModelMetadata metadataForClass:modelClass];
+        self.metadataByClass[(id<NSCopying>)modelClass] = metadata;
+    }
+    return metadata;
+}
+
+- (BOOL)appendModel:(AWSMTLModel<AWSMTLJSONSerializing> *)model shape:(AWSShape *)shape {
+    AWSJSONModelMetadata *metadata = [self metadataForClass:[model class]];
+
+    AWSJSONEncoderAppend(self.data, "{");
+    BOOL first = YES;
+    for (AWSShapeMember *member in shape.members) {
+        if (member.location != AWSShapeMemberLocationBody) {
+            continue;
+        }
+        NSString *propertyKey = metadata.propertyKeysByJSONKey[member.name];
+        if (!propertyKey) {
+            continue;
+        }
+        id value = [model valueForKey:propertyKey];
+        if (!value || value == [NSNull null]) {
+            continue;
+        }
+
+        // Collections and nested models are written through their shapes below. Other values go through the
+        // transformer of the property, as AWSMTLJSONAdapter would, to turn enums back into their strings.
+        NSValueTransformer *transformer = metadata.transformersByPropertyKey[propertyKey];
+        if (transformer
+            && [[transformer class] allowsReverseTransformation]
+            && ![self canAppendValueWithoutTransformer:value shape:member.shape]) {
+            value = [transformer reverseTransformedValue:value];
+            if (!value || value == [NSNull null]) {
+                continue;
+            }
+        }
+
+        if (!first) {
+            AWSJSONEncoderAppend(self.data, ",");
+        }
+        first = NO;
+        AWSJSONEncoderAppendString(self.data, member.locationName);
+        AWSJSONEncoderAppend(self.data, ":");
+        if (![self appendValue:value shape:member.shape]) {
+            return NO;
+        }
+    }
+    AWSJSONEncoderAppend(self.data, "}");
+    return YES;
+}
+
+- (BOOL)canAppendValueWithoutTransformer:(id)value shape:(AWSShape *)shape {
+    switch (shape.type) {
+        case AWSShapeTypeStructure:
+            return [value isKindOfClass:[AWSMTLModel class]] || [value isKindOfClass:[NSDictionary class]];
+        case AWSShapeTypeList:
+            return [value isKindOfClass:[NSArray class]];
+        case AWSShapeTypeMap:
+            return [value isKindOfClass:[NSDictionary class]];
+        case AWSShapeTypeTimestamp:
+            return [value isKindOfClass:[NSDate class]];
+        default:
+            return NO;
+    }
+}
+
+// Writes a value the way AWSJSONBuilder serializes the same value of the shape, followed by NSJSONSerialization.
+- (BOOL)appendValue:(id)value shape:(AWSShape *)shape {
+    switch (shape.type) {
+        case AWSShapeTypeStructure:
+            if ([value isKindOfClass:[AWSMTLModel class]] && [value conformsToProtocol:@protocol(AWSMTLJSONSerializing)]) {
+                return [self appendModel:value shape:shape];
+            }
+            if (![value isKindOfClass:[NSDictionary class]]) {
+                return [self failWithDescription:[NSString stringWithFormat:@"a structure input should be a dictionary but got:%@", value]];
+            }
+            return [self appendDictionary:value shape:shape];
+
+        case AWSShapeTypeList: {
+            if (![value isKindOfClass:[NSArray class]]) {
+                return [self failWithDescription:[NSString stringWithFormat:@"a list input should be an array but got:%@", value]];
+            }
+            AWSShape *memberShape = shape.listMember.shape;
+            AWSJSONEncoderAppend(self.data, "[");
+            BOOL first = YES;
+            for (id element in value) {
+                if (!first) {
+                    AWSJSONEncoderAppend(self.data, ",");
+                }
+                first = NO;
+                if (![self appendValue:element shape:memberShape]) {
+                    return NO;
+                }
+            }
+            AWSJSONEncoderAppend(self.data, "]");
+            return YES;
+        }
+
+        case AWSShapeTypeMap: {
+            if (![value isKindOfClass:[NSDictionary class]]) {
+                return [self failWithDescription:[NSString stringWithFormat:@"a map input should be a dictionary but got:%@", value]];
+            }
+            AWSShape *valueShape = shape.mapValue.shape;
+            AWSJSONEncoderAppend(self.data, "{");
+            __block BOOL first = YES;
+            __block BOOL succeeded = YES;
+            [value enumerateKeysAndObjectsUsingBlock:^(id key, id object, BOOL *stop) {
+                if (![key isKindOfClass:[NSString class]]) {
+                    succeeded = [self failWithDescription:[NSString stringWithFormat:@"a map key should be a string but got:%@", key]];
+                    *stop = YES;
+                    return;
+                }
+                if (!first) {
+                    AWSJSONEncoderAppend(self.data, ",");
+                }
+                first = NO;
+                AWSJSONEncoderAppendString(self.data, key);
+                AWSJSONEncoderAppend(self.data, ":");
+                if (![self appendValue:object shape:valueShape]) {
+                    succeeded = NO;
+                    *stop = YES;
+                }
+            }];
+            if (!succeeded) {
+                return NO;
+            }
+            AWSJSONEncoderAppend(self.data, "}");
+            return YES;
+        }
+
+        case AWSShapeTypeBoolean:
+            if ([value isKindOfClass:[NSNumber class]]) {
+                AWSJSONEncoderAppend(self.data, [value boolValue] ? "true" : "false");
+                return YES;
+            }
+            return [self appendJSONObject:value];
+
+        case AWSShapeTypeInteger:
+        case AWSShapeTypeLong:
+            if ([value isKindOfClass:[NSNumber class]] && !AWSJSONEncoderIsBoolean(value)) {
+                AWSJSONEncoderAppendNumber(self.data, value, NO);
+                return YES;
+            }
+            return [self appendJSONObject:value];
+
+        case AWSShapeTypeFloat:
+        case AWSShapeTypeDouble:
+            if ([value isKindOfClass:[NSNumber class]] && !AWSJSONEncoderIsBoolean(value)) {
+                if (!AWSJSONEncoderAppendNumber(self.data, value, YES)) {
+                    return [self failWithDescription:[NSString stringWithFormat:@"invalid number value:%@", value]];
+                }
+                return YES;
+            }
+            return [self appendJSONObject:value];
+
+        case AWSShapeTypeTimestamp: {
+            NSDate *timeStampDate = nil;
+            if ([value isKindOfClass:[NSString class]]) {
+                timeStampDate = [NSDate aws_dateFromString:value];
+                if (!timeStampDate) {
+                    timeStampDate = [NSDate dateWithTimeIntervalSince1970:[value doubleValue]];
+                }
+            } else if ([value isKindOfClass:[NSNumber class]]) {
+                timeStampDate = [NSDate dateWithTimeIntervalSince1970:[value doubleValue]];
+            } else if ([value isKindOfClass:[NSDate class]]) {
+                timeStampDate = value;
+            }
+            if (!AWSJSONEncoderAppendNumber(self.data, @([timeStampDate timeIntervalSince1970]), YES)) {
+                return [self failWithDescription:[NSString stringWithFormat:@"invalid timestamp value:%@", value]];
+            }
+            return YES;
+        }
+
+        case AWSShapeTypeBlob:
+            if ([value isKindOfClass:[NSString class]]) {
+                value = [value dataUsingEncoding:NSUTF8StringEncoding];
+            }
+            if (![value isKindOfClass:[NSData class]]) {
+                return [self failWithDescription:@"'blob' value should be a NSData type."];
+            }
+            AWSJSONEncoderAppendString(self.data, [value base64EncodedStringWithOptions:0]);
+            return YES;
+
+        default:
+            return [self appendJSONObject:value];
+    }
+}
+
+// Writes the members of a structure given as a dictionary keyed by member name, as AWSJSONBuilder takes it.
+- (BOOL)appendDictionary:(NSDictionary *)dictionary shape:(AWSShape *)shape {
+    AWSJSONEncoderAppend(self.data, "{");
+    BOOL first = YES;
+    for (AWSShapeMember *member in shape.members) {
+        id value = dictionary[member.name];
+        if (!value || value == [NSNull null] || member.location != AWSShapeMemberLocationBody) {
+            continue;
+        }
+        if (!first) {
+            AWSJSONEncoderAppend(self.data, ",");
+        }
+        first = NO;
+        AWSJSONEncoderAppendString(self.data, member.locationName);
+        AWSJSONEncoderAppend(self.data, ":");
+        if (![self appendValue:value shape:member.shape]) {
+            return NO;
+        }
+    }
+    AWSJSONEncoderAppend(self.data, "}");
+    return YES;
+}
+
+// Writes a value without a shape to guide it, as NSJSONSerialization would.
+- (BOOL)appendJSONObject:(id)value {
+    if ([value isKindOfClass:[NSString class]]) {
+        AWSJSONEncoderAppendString(self.data, value);
+    } else if ([value isKindOfClass:[NSNumber class]]) {
+        if (AWSJSONEncoderIsBoolean(value)) {
+            AWSJSONEncoderAppend(self.data, [value boolValue] ? "true" : "false");
+        } else if (!AWSJSONEncoderAppendNumber(self.data, value, NO)) {
+            return [self failWithDescription:[NSString stringWithFormat:@"invalid number value:%@", value]];
+        }
+    } else if (value == [NSNull null]) {
+        AWSJSONEncoderAppend(self.data, "null");
+    } else if ([value isKindOfClass:[NSArray class]]) {
+        AWSJSONEncoderAppend(self.data, "[");
+        BOOL first = YES;
+        for (id element in value) {
+            if (!first) {
+                AWSJSONEncoderAppend(self.data, ",");
+            }
+            first = NO;
+            if (![self appendJSONObject:element]) {
+                return NO;
+            }
+        }
+        AWSJSONEncoderAppend(self.data, "]");
+    } else if ([value isKindOfClass:[NSDictionary class]]) {
+        AWSJSONEncoderAppend(self.data, "{");
+        BOOL first = YES;
+        for (id key in value) {
+            if (![key isKindOfClass:[NSString class]]) {
+                return [self failWithDescription:[NSString stringWithFormat:@"a dictionary key should be a string but got:%@", key]];
+            }
+            if (!first) {
+                AWSJSONEncoderAppend(self.data, ",");
+            }
+            first = NO;
+            AWSJSONEncoderAppendString(self.data, key);
+            AWSJSONEncoderAppend(self.data, ":");
+            if (![self appendJSONObject:value[key]]) {
+                return NO;
+            }
+        }
+        AWSJSONEncoderAppend(self.data, "}");
+    } else {
+        return [self failWithDescription:[NSString stringWithFormat:@"serialized object is neither a valid json Object nor NSData object: %@", value]];
+    }
+    return YES;
+}
+
+@end
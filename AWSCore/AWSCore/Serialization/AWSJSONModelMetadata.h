@@ -0,0 +1,68 @@
+/*
+ Copyright 2010-2015 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License").
+ You may not use this file except in compliance with the License.
+ A copy of the License is located at
+
+ http://aws.amazon.com/apache2.0
+
+ or in the "license" file accompanying this file. This file is distributed
+ on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ express or implied. See the License for the specific language governing
+ permissions and limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class AWSShape;
+
+/**
+ The JSON mapping of a model class, read once from its `AWSMTLJSONSerializing` methods: which property each JSON key
+ maps to and the transformer `AWSMTLJSONAdapter` would apply to it.
+ */
+@interface AWSJSONModelMetadata : NSObject
+
+@property (nonatomic, assign, readonly) Class modelClass;
+
+/**
+ Property keys by the JSON key they map to. Properties mapped to `NSNull` or to nested key paths are left out.
+ */
+@property (nonatomic, strong, readonly) NSDictionary *propertyKeysByJSONKey;
+
+/**
+ The JSON transformers of the properties that have one.
+ */
+@property (nonatomic, strong, readonly) NSDictionary *transformersByPropertyKey;
+
+/**
+ Returns the cached metadata of the given model class.
+ */
++ (instancetype)metadataForClass:(Class)modelClass;
+
+@end
+
+/**
+ Binds the structure shapes reachable from an operation output to the model classes generated for them. A generated
+ model class is named after its shape with the prefix of the service, so the classes are found from the output class.
+ */
+@interface AWSJSONModelShapeMapping : NSObject
+
+/**
+ Returns the cached mapping for the output shape and class of an operation, or `nil` when a structure reachable from
+ the shape has no model class that can be created from a dictionary of its members.
+ */
++ (instancetype)mappingForShape:(AWSShape *)shape
+                     modelClass:(Class)modelClass;
+
+/**
+ Returns the metadata of the model class of a structure shape.
+ */
+- (AWSJSONModelMetadata *)metadataForShape:(AWSShape *)shape;
+
+/**
+ Returns whether a list or map shape holds structures, at any depth of nested lists and maps.
+ */
+- (BOOL)shapeHoldsModels:(AWSShape *)shape;
+
+@end
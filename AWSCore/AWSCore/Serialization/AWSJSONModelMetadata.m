@@ -0,0 +1,201 @@
+/*
+ Copyright 2010-2015 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License").
+ You may not use this file except in compliance with the License.
+ A copy of the License is located at
+
+ http://aws.amazon.com/apache2.0
+
+ or in the "license" file accompanying this file. This file is distributed
+ on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ express or implied. See the License for the specific language governing
+ permissions and limitations under the License.
+ */
+
+#import "AWSJSONModelMetadata.h"
+
+#import <objc/message.h>
+#import "AWSMantle.h"
+#import "AWSMTLReflection.h"
+#import "AWSServiceModel.h"
+
+@interface AWSJSONModelMetadata()
+
+@property (nonatomic, assign) Class modelClass;
+@property (nonatomic, strong) NSDictionary *propertyKeysByJSONKey;
+@property (nonatomic, strong) NSDictionary *transformersByPropertyKey;
+
+@end
+
+@implementation AWSJSONModelMetadata
+
++ (instancetype)metadataForClass:(Class)modelClass {
+    static NSMutableDictionary *metadataByClass = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        metadataByClass = [NSMutableDictionary new];
+    });
+
+    @synchronized(metadataByClass) {
+        AWSJSONModelMetadata *metadata = metadataByClass[(id<NSCopying>)modelClass];
+        if (!metadata) {
+            metadata = [[AWSJSONModelMetadata alloc] initWithClass:modelClass];
+            metadataByClass[(id<NSCopying>)modelClass] = metadata;
+        }
+        return metadata;
+    }
+}
+
+- (instancetype)initWithClass:(Class)modelClass {
+    if (self = [super init]) {
+        _modelClass = modelClass;
+
+        NSDictionary *JSONKeyPathsByPropertyKey = [modelClass JSONKeyPathsByPropertyKey];
+        NSMutableDictionary *propertyKeysByJSONKey = [NSMutableDictionary new];
+        NSMutableDictionary *transformersByPropertyKey = [NSMutableDictionary new];
+        for (NSString *propertyKey in [modelClass propertyKeys]) {
+            // The same mapping as -[AWSMTLJSONAdapter JSONKeyPathForPropertyKey:].
+            id JSONKeyPath = JSONKeyPathsByPropertyKey[propertyKey] ?: propertyKey;
+            if (![JSONKeyPath isKindOfClass:[NSString class]]
+                || [JSONKeyPath rangeOfString:@"."].location != NSNotFound) {
+                continue;
+            }
+            propertyKeysByJSONKey[JSONKeyPath] = propertyKey;
+
+            // The same lookup as -[AWSMTLJSONAdapter JSONTransformerForKey:].
+            NSValueTransformer *transformer = nil;
+            SEL selector = AWSMTLSelectorWithKeyPattern(propertyKey, "JSONTransformer");
+            if ([modelClass respondsToSelector:selector]) {
+                transformer = ((NSValueTransformer *(*)(id, SEL))objc_msgSend)(modelClass, selector);
+            } else if ([modelClass respondsToSelector:@selector(JSONTransformerForKey:)]) {
+                transformer = [modelClass JSONTransformerForKey:propertyKey];
+            }
+            if (transformer) {
+                transformersByPropertyKey[propertyKey] = transformer;
+            }
+        }
+        _propertyKeysByJSONKey = propertyKeysByJSONKey;
+        _transformersByPropertyKey = transformersByPropertyKey;
+    }
+    return self;
+}
+
+@end
+
+@interface AWSJSONModelShapeMapping()
+
+@property (nonatomic, strong) NSString *classPrefix;
+@property (nonatomic, strong) NSMutableDictionary *metadataByShapeName;
+@property (nonatomic, strong) NSMutableDictionary *holdsModelsByShapeName;
+
+@end
+
+@implementation AWSJSONModelShapeMapping
+
++ (instancetype)mappingForShape:(AWSShape *)shape
+                     modelClass:(Class)modelClass {
+    if (!shape || !modelClass) {
+        return nil;
+    }
+
+    static NSMapTable *mappings = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        mappings = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality
+                                         valueOptions:NSPointerFunctionsStrongMemory];
+    });
+
+    @synchronized(mappings) {
+        id mapping = [mappings objectForKey:shape];
+        if (!mapping) {
+            mapping = [[AWSJSONModelShapeMapping alloc] initWithShape:shape modelClass:modelClass] ?: [NSNull null];
+            [mappings setObject:mapping forKey:shape];
+        }
+        return mapping == [NSNull null] ? nil : mapping;
+    }
+}
+
+- (instancetype)initWithShape:(AWSShape *)shape
+                   modelClass:(Class)modelClass {
+    if (self = [super init]) {
+        NSString *className = NSStringFromClass(modelClass);
+        if (![className hasSuffix:shape.name]) {
+            return nil;
+        }
+        _classPrefix = [className substringToIndex:[className length] - [shape.name length]];
+        _metadataByShapeName = [NSMutableDictionary new];
+        _holdsModelsByShapeName = [NSMutableDictionary new];
+
+        NSMutableDictionary *visitedShapes = [NSMutableDictionary new];
+        if (![self mapShape:shape visitedShapes:visitedShapes]) {
+            return nil;
+        }
+        // Worked out up front, as the mapping is shared by the decoders of every thread.
+        for (AWSShape *visitedShape in [visitedShapes allValues]) {
+            if (visitedShape.type == AWSShapeTypeList || visitedShape.type == AWSShapeTypeMap) {
+                [self computeHoldsModelsForShape:visitedShape];
+            }
+        }
+    }
+    return self;
+}
+
+- (BOOL)mapShape:(AWSShape *)shape visitedShapes:(NSMutableDictionary *)visitedShapes {
+    if (!shape || visitedShapes[shape.name]) {
+        return YES;
+    }
+    visitedShapes[shape.name] = shape;
+
+    switch (shape.type) {
+        case AWSShapeTypeStructure: {
+            Class modelClass = NSClassFromString([self.classPrefix stringByAppendingString:shape.name]);
+            if (![modelClass isSubclassOfClass:[AWSMTLModel class]]
+                || ![modelClass conformsToProtocol:@protocol(AWSMTLJSONSerializing)]
+                || [modelClass respondsToSelector:@selector(classForParsingJSONDictionary:)]) {
+                return NO;
+            }
+            self.metadataByShapeName[shape.name] = [AWSJSONModelMetadata metadataForClass:modelClass];
+            for (AWSShapeMember *member in shape.members) {
+                if (![self mapShape:member.shape visitedShapes:visitedShapes]) {
+                    return NO;
+                }
+            }
+            return YES;
+        }
+        case AWSShapeTypeList:
+            return [self mapShape:shape.listMember.shape visitedShapes:visitedShapes];
+        case AWSShapeTypeMap:
+            return [self mapShape:shape.mapValue.shape visitedShapes:visitedShapes];
+        default:
+            return YES;
+    }
+}
+
+- (AWSJSONModelMetadata *)metadataForShape:(AWSShape *)shape {
+    return self.metadataByShapeName[shape.name];
+}
+
+- (BOOL)shapeHoldsModels:(AWSShape *)shape {
+    return [self.holdsModelsByShapeName[shape.name] boolValue];
+}
+
+- (BOOL)computeHoldsModelsForShape:(AWSShape *)shape {
+    NSNumber *holdsModels = self.holdsModelsByShapeName[shape.name];
+    if (!holdsModels) {
+        AWSShape *elementShape = nil;
+        if (shape.type == AWSShapeTypeList) {
+            elementShape = shape.listMember.shape;
+        } else if (shape.type == AWSShapeTypeMap) {
+            elementShape = shape.mapValue.shape;
+        }
+        // Marks the shape first so that a list or map holding itself ends the recursion.
+        self.holdsModelsByShapeName[shape.name] = @NO;
+        holdsModels = @(elementShape.type == AWSShapeTypeStructure
+                        || (elementShape && [self computeHoldsModelsForShape:elementShape]));
+        self.holdsModelsByShapeName[shape.name] = holdsModels;
+    }
+    return [holdsModels boolValue];
+}
+
+@end
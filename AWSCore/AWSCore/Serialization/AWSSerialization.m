@@ -14,6 +14,7 @@
  */
 
 #import "AWSSerialization.h"
+#import "AWSServiceModel.h"
 #import "AWSXMLWriter.h"
 #import "AWSCategory.h"
 #import "AWSLogging.h"
@@ -37,7 +38,9 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
 - (instancetype)initWithDictionary:(NSDictionary *)otherDictionary JSONDefinitionRule:(NSDictionary *)rule {
     self = [super init];
     if (self) {
-        _embeddedDictionary = [[NSDictionary alloc] initWithDictionary:otherDictionary];
+        // The service definitions are immutable, so copying a part of one only retains it. Building a new
+        // dictionary here made every rule lookup copy the whole members table it came from.
+        _embeddedDictionary = [otherDictionary copy];
         _JSONDefinitionRule = [rule copy];
     }
     return self;
@@ -1511,11 +1514,6 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
                                                                options:NSJSONReadingAllowFragments
                                                                  error:error];
 
-    NSDictionary *actionRule = [[[serviceDefinitionRule objectForKey:@"operations"] objectForKey:actionName] objectForKey:@"output"];
-    if (actionRule == (id)[NSNull null]) {
-        actionRule = @{};
-    }
-
     NSDictionary *definitionRules = [serviceDefinitionRule objectForKey:@"shapes"];
     if (definitionRules == (id)[NSNull null]) {
         definitionRules = @{};
@@ -1530,46 +1528,32 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
         return result;
     }
 
-    AWSJSONDictionary *rules = [[AWSJSONDictionary alloc] initWithDictionary:actionRule JSONDefinitionRule:definitionRules];
+    AWSShape *outputShape = [[AWSServiceModel serviceModelWithDefinition:serviceDefinitionRule] outputShapeForOperationName:actionName];
 
     //check if has payload tag.
-    NSString *isPayloadData = rules[@"payload"];
+    NSString *isPayloadData = outputShape.payloadMemberName;
 
     NSMutableDictionary *parsedData = [NSMutableDictionary new];
 
     if (isPayloadData) {
         //check if it is streaming type
-        if (rules[@"members"][isPayloadData][@"streaming"]) {
+        if ([outputShape memberNamed:isPayloadData].streaming) {
             parsedData[isPayloadData] = data;
             if (error) *error = nil;
             return parsedData;
         }
 
-        rules = rules[isPayloadData][@"members"];
-        parsedData[isPayloadData] = [self serializeMember:rules value:result target:nil error:error];
+        parsedData[isPayloadData] = result;
 
     } else {
-        parsedData = [self serializeMember:rules value:result target:nil error:error];
+        parsedData = [self serializeShape:outputShape value:result target:nil error:error];
     }
 
 
     return parsedData;
 }
 
-+ (NSString *)findMemberName:(NSString*)locationName structureRules:(NSDictionary *)structureRules {
-
-    for (NSString *aMember in structureRules[@"members"]) {
-        NSDictionary *memberShape = structureRules[@"members"][aMember];
-
-        if ([memberShape[@"locationName"] isEqualToString:locationName]) {
-            return aMember;
-        }
-    }
-
-    return locationName;
-}
-
-+ (id)serializeStructure:(NSDictionary *)structureRules values:(NSDictionary *)values target:(id)target error:(NSError *__autoreleasing *)error{
++ (id)serializeStructure:(AWSShape *)structureShape values:(NSDictionary *)values target:(id)target error:(NSError *__autoreleasing *)error{
     if (!target) {
         target = [NSMutableDictionary new];
     }
@@ -1577,12 +1561,9 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
     for (NSString *serialized_name in values) {
         id value = values[serialized_name];
 
-        NSString *memberName = [self findMemberName:serialized_name structureRules:structureRules];
-
-        AWSJSONDictionary *memberShape = structureRules[@"members"][memberName];
-        if (memberShape && value) {
-            // NSString *name = memberShape[@"locationName"]?memberShape[@"locationName"]:serialized_name;
-            target[memberName] = [self serializeMember:memberShape value:value target:nil error:(NSError *__autoreleasing *)error];
+        AWSShapeMember *member = [structureShape memberWithLocationName:serialized_name] ?: [structureShape memberNamed:serialized_name];
+        if (member && value) {
+            target[member.name] = [self serializeShape:member.shape value:value target:nil error:(NSError *__autoreleasing *)error];
         }
 
     }
@@ -1590,39 +1571,41 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
 
 }
 
-+ (NSMutableArray *)serializeList:(NSDictionary *)listRules values:(NSDictionary *)values target:(id)target error:(NSError *__autoreleasing *)error{
++ (NSMutableArray *)serializeList:(AWSShape *)listShape values:(NSDictionary *)values target:(id)target error:(NSError *__autoreleasing *)error{
     if (!target) {
         target = [NSMutableArray new];
     }
 
+    AWSShape *memberShape = listShape.listMember.shape;
     for (NSString *value in values) {
-        [target addObject:[self serializeMember:listRules[@"member"] value:value target:nil error:(NSError *__autoreleasing *)error]];
+        [target addObject:[self serializeShape:memberShape value:value target:nil error:(NSError *__autoreleasing *)error]];
     }
 
     return target;
 }
 
-+ (NSMutableDictionary *) serializeMap:(NSDictionary *)mapRules values:(NSDictionary *)values target:(id)target error:(NSError *__autoreleasing *)error{
++ (NSMutableDictionary *) serializeMap:(AWSShape *)mapShape values:(NSDictionary *)values target:(id)target error:(NSError *__autoreleasing *)error{
     if (!target) {
         target = [NSMutableDictionary new];
     }
 
+    AWSShape *valueShape = mapShape.mapValue.shape;
     for (NSString *key in values) {
         id value = values[key];
 
-        target[key] = [self serializeMember:mapRules[@"value"] value:value target:nil error:(NSError *__autoreleasing *)error];
+        target[key] = [self serializeShape:valueShape value:value target:nil error:(NSError *__autoreleasing *)error];
     }
 
     return target;
 }
 
-+ (id)serializeMember:(NSDictionary *)shape value:(id)value target:(id)target error:(NSError *__autoreleasing *)error{
++ (id)serializeShape:(AWSShape *)shape value:(id)value target:(id)target error:(NSError *__autoreleasing *)error{
     if (!value) {
         return nil;
     }
 
-    NSString *rulesType = shape[@"type"];
-    if ([rulesType isEqualToString:@"structure"]) {
+    AWSShapeType rulesType = shape.type;
+    if (rulesType == AWSShapeTypeStructure) {
 
         if (![value isKindOfClass:[NSDictionary class]]) {
             if (![value isKindOfClass:[NSNull class]]) {
@@ -1634,7 +1617,7 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
             return [self serializeStructure:shape values:value target:target error:error];
         }
 
-    } else if ([rulesType isEqualToString:@"list"]) {
+    } else if (rulesType == AWSShapeTypeList) {
 
         if (![value isKindOfClass:[NSArray class]]) {
             if (![value isKindOfClass:[NSNull class]]) {
@@ -1646,7 +1629,7 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
         }
 
 
-    } else if ([rulesType isEqualToString:@"map"]) {
+    } else if (rulesType == AWSShapeTypeMap) {
 
         if (![value isKindOfClass:[NSDictionary class]]) {
             if (![value isKindOfClass:[NSNull class]]) {
@@ -1657,7 +1640,7 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
             return [self serializeMap:shape values:value target:target error:error];
         }
         
-    } else if ([rulesType isEqualToString:@"timestamp"]) {
+    } else if (rulesType == AWSShapeTypeTimestamp) {
         
         NSDate *timeStampDate;
         //maybe a NSDate type or NSNumber type or NSString type
@@ -1680,7 +1663,7 @@ NSString *const AWSJSONParserErrorDomain = @"com.amazonaws.AWSJSONParserErrorDom
         return [NSNumber numberWithDouble:[timeStampDate timeIntervalSince1970]];
         
         
-    } else if ([rulesType isEqualToString:@"blob"]) {
+    } else if (rulesType == AWSShapeTypeBlob) {
         
         //decode Base64Str to NSData
         if ([value isKindOfClass:[NSString class]]) {
@@ -0,0 +1,182 @@
+/*
+ Copyright 2010-2015 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License").
+ You may not use this file except in compliance with the License.
+ A copy of the License is located at
+
+ http://aws.amazon.com/apache2.0
+
+ or in the "license" file accompanying this file. This file is distributed
+ on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ express or implied. See the License for the specific language governing
+ permissions and limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+typedef NS_ENUM(NSInteger, AWSShapeType) {
+    AWSShapeTypeUnknown,
+    AWSShapeTypeStructure,
+    AWSShapeTypeList,
+    AWSShapeTypeMap,
+    AWSShapeTypeString,
+    AWSShapeTypeInteger,
+    AWSShapeTypeLong,
+    AWSShapeTypeFloat,
+    AWSShapeTypeDouble,
+    AWSShapeTypeBoolean,
+    AWSShapeTypeTimestamp,
+    AWSShapeTypeBlob,
+};
+
+typedef NS_ENUM(NSInteger, AWSShapeMemberLocation) {
+    AWSShapeMemberLocationBody,
+    AWSShapeMemberLocationHeader,
+    AWSShapeMemberLocationHeaders,
+    AWSShapeMemberLocationURI,
+    AWSShapeMemberLocationQueryString,
+    AWSShapeMemberLocationStatusCode,
+};
+
+@class AWSShape;
+
+/**
+ A member of a structure, or the member, key or value of a list or map, with the reference to its shape resolved.
+ */
+@interface AWSShapeMember : NSObject
+
+/**
+ The member name in the service definition. It is the key of the member in the dictionaries of AWSMTLJSONAdapter.
+ */
+@property (nonatomic, strong, readonly) NSString *name;
+
+/**
+ The shape of the member. It stays valid as long as the service model that compiled it.
+ */
+@property (nonatomic, weak, readonly) AWSShape *shape;
+
+@property (nonatomic, assign, readonly) AWSShapeMemberLocation location;
+
+/**
+ The name of the member on the wire: its JSON key, header name, URI label, query string key or XML element name.
+ */
+@property (nonatomic, strong, readonly) NSString *locationName;
+
+/**
+ The name of the elements holding the member in XML. It differs from `locationName` for flattened lists and maps,
+ whose entries are repeated directly under the parent element.
+ */
+@property (nonatomic, strong, readonly) NSString *xmlName;
+
+@property (nonatomic, assign, readonly, getter=isFlattened) BOOL flattened;
+@property (nonatomic, assign, readonly, getter=isStreaming) BOOL streaming;
+@property (nonatomic, assign, readonly, getter=isXMLAttribute) BOOL xmlAttribute;
+
+/**
+ The timestamp format of the member, or nil for the protocol default.
+ */
+@property (nonatomic, strong, readonly) NSString *timestampFormat;
+
+/**
+ The member reference in the service definition.
+ */
+@property (nonatomic, strong, readonly) NSDictionary *rules;
+
+@end
+
+/**
+ A shape of the service definition compiled into a form that is cheap to walk: its type is an enum, the shapes of
+ its members are resolved, and its members are indexed by every name they appear under.
+ */
+@interface AWSShape : NSObject
+
+/**
+ The index of the shape in `-[AWSServiceModel shapes]`.
+ */
+@property (nonatomic, assign, readonly) NSUInteger shapeID;
+@property (nonatomic, strong, readonly) NSString *name;
+@property (nonatomic, assign, readonly) AWSShapeType type;
+
+/**
+ The members of a structure, ordered by name.
+ */
+@property (nonatomic, strong, readonly) NSArray *members;
+
+/**
+ The member of a list.
+ */
+@property (nonatomic, strong, readonly) AWSShapeMember *listMember;
+
+/**
+ The key and value of a map.
+ */
+@property (nonatomic, strong, readonly) AWSShapeMember *mapKey;
+@property (nonatomic, strong, readonly) AWSShapeMember *mapValue;
+
+/**
+ The name of the member of a structure sent or received as the body, if any.
+ */
+@property (nonatomic, strong, readonly) NSString *payloadMemberName;
+
+@property (nonatomic, strong, readonly) NSArray *requiredMemberNames;
+@property (nonatomic, strong, readonly) NSNumber *min;
+@property (nonatomic, strong, readonly) NSNumber *max;
+@property (nonatomic, strong, readonly) NSString *pattern;
+@property (nonatomic, assign, readonly, getter=isStreaming) BOOL streaming;
+
+/**
+ The shape in the service definition.
+ */
+@property (nonatomic, strong, readonly) NSDictionary *rules;
+
+/**
+ Returns the member of a structure with the given name in the service definition.
+ */
+- (AWSShapeMember *)memberNamed:(NSString *)name;
+
+/**
+ Returns the member of a structure with the given `locationName`, such as a JSON key or a header name.
+ */
+- (AWSShapeMember *)memberWithLocationName:(NSString *)locationName;
+
+/**
+ Returns the member of a structure held by XML elements with the given name.
+ */
+- (AWSShapeMember *)memberWithXMLName:(NSString *)xmlName;
+
+@end
+
+/**
+ A service definition compiled once into shape tables. The `*Resources` singletons keep their definitions for the
+ life of the app, so each is compiled on the first request to its service and shared by the serializers afterwards.
+ */
+@interface AWSServiceModel : NSObject
+
+/**
+ Returns the compiled model of the given service definition, compiling it on the first call.
+ @param definition The service definition, as returned by `-[AWS*Resources JSONObject]`.
+ */
++ (instancetype)serviceModelWithDefinition:(NSDictionary *)definition;
+
+/**
+ The service definition. It is not retained by the model; callers keep it alive, as the `*Resources` singletons do.
+ */
+@property (nonatomic, weak, readonly) NSDictionary *definition;
+
+/**
+ The shapes of the service, indexed by shape ID.
+ */
+@property (nonatomic, strong, readonly) NSArray *shapes;
+
+- (AWSShape *)shapeNamed:(NSString *)name;
+
+- (AWSShape *)shapeWithID:(NSUInteger)shapeID;
+
+/**
+ Returns the shape of the input or output of the given operation, or nil if it has none.
+ */
+- (AWSShape *)inputShapeForOperationName:(NSString *)operationName;
+- (AWSShape *)outputShapeForOperationName:(NSString *)operationName;
+
+@end
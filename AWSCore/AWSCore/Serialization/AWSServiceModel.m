@@ -0,0 +1,299 @@
+/*
+ Copyright 2010-2015 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License").
+ You may not use this file except in compliance with the License.
+ A copy of the License is located at
+
+ http://aws.amazon.com/apache2.0
+
+ or in the "license" file accompanying this file. This file is distributed
+ on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ express or implied. See the License for the specific language governing
+ permissions and limitations under the License.
+ */
+
+#import "AWSServiceModel.h"
+
+static AWSShapeType AWSShapeTypeFromString(NSString *type) {
+    static NSDictionary *shapeTypes = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        shapeTypes = @{@"structure" : @(AWSShapeTypeStructure),
+                       @"list" : @(AWSShapeTypeList),
+                       @"map" : @(AWSShapeTypeMap),
+                       @"string" : @(AWSShapeTypeString),
+                       @"integer" : @(AWSShapeTypeInteger),
+                       @"long" : @(AWSShapeTypeLong),
+                       @"float" : @(AWSShapeTypeFloat),
+                       @"double" : @(AWSShapeTypeDouble),
+                       @"boolean" : @(AWSShapeTypeBoolean),
+                       @"timestamp" : @(AWSShapeTypeTimestamp),
+                       @"blob" : @(AWSShapeTypeBlob)};
+    });
+    return [shapeTypes[type] integerValue];
+}
+
+static AWSShapeMemberLocation AWSShapeMemberLocationFromString(NSString *location) {
+    static NSDictionary *locations = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        locations = @{@"header" : @(AWSShapeMemberLocationHeader),
+                      @"headers" : @(AWSShapeMemberLocationHeaders),
+                      @"uri" : @(AWSShapeMemberLocationURI),
+                      @"querystring" : @(AWSShapeMemberLocationQueryString),
+                      @"statusCode" : @(AWSShapeMemberLocationStatusCode)};
+    });
+    return [locations[location] integerValue];
+}
+
+@interface AWSShapeMember()
+
+@property (nonatomic, strong) NSString *name;
+@property (nonatomic, weak) AWSShape *shape;
+@property (nonatomic, assign) AWSShapeMemberLocation location;
+@property (nonatomic, strong) NSString *locationName;
+@property (nonatomic, strong) NSString *xmlName;
+@property (nonatomic, assign, getter=isFlattened) BOOL flattened;
+@property (nonatomic, assign, getter=isStreaming) BOOL streaming;
+@property (nonatomic, assign, getter=isXMLAttribute) BOOL xmlAttribute;
+@property (nonatomic, strong) NSString *timestampFormat;
+@property (nonatomic, strong) NSDictionary *rules;
+
+@end
+
+@implementation AWSShapeMember
+
+- (instancetype)initWithName:(NSString *)name
+                       rules:(NSDictionary *)rules
+                serviceModel:(AWSServiceModel *)serviceModel {
+    if (self = [super init]) {
+        AWSShape *shape = [serviceModel shapeNamed:rules[@"shape"]];
+        NSDictionary *shapeRules = shape.rules;
+
+        _name = name;
+        _shape = shape;
+        _rules = rules;
+        _location = AWSShapeMemberLocationFromString(rules[@"location"]);
+        // Keys of the member reference take precedence over the keys of the shape it refers to.
+        _locationName = rules[@"locationName"] ?: shapeRules[@"locationName"] ?: name;
+        _flattened = [(rules[@"flattened"] ?: shapeRules[@"flattened"]) boolValue];
+        _streaming = [(rules[@"streaming"] ?: shapeRules[@"streaming"]) boolValue];
+        _xmlAttribute = [(rules[@"xmlAttribute"] ?: shapeRules[@"xmlAttribute"]) boolValue];
+        _timestampFormat = rules[@"timestampFormat"] ?: shapeRules[@"timestampFormat"];
+
+        _xmlName = _locationName;
+        if (_flattened && shape.type == AWSShapeTypeList) {
+            NSDictionary *listMemberRules = shapeRules[@"member"];
+            _xmlName = listMemberRules[@"locationName"] ?: _locationName;
+        }
+    }
+    return self;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p; name = %@; shape = %@>",
+            NSStringFromClass([self class]),
+            self,
+            self.name,
+            self.shape.name];
+}
+
+@end
+
+@interface AWSShape()
+
+@property (nonatomic, assign) NSUInteger shapeID;
+@property (nonatomic, strong) NSString *name;
+@property (nonatomic, assign) AWSShapeType type;
+@property (nonatomic, strong) NSArray *members;
+@property (nonatomic, strong) AWSShapeMember *listMember;
+@property (nonatomic, strong) AWSShapeMember *mapKey;
+@property (nonatomic, strong) AWSShapeMember *mapValue;
+@property (nonatomic, strong) NSString *payloadMemberName;
+@property (nonatomic, strong) NSArray *requiredMemberNames;
+@property (nonatomic, strong) NSNumber *min;
+@property (nonatomic, strong) NSNumber *max;
+@property (nonatomic, strong) NSString *pattern;
+@property (nonatomic, assign, getter=isStreaming) BOOL streaming;
+@property (nonatomic, strong) NSDictionary *rules;
+
+@property (nonatomic, strong) NSDictionary *membersByName;
+@property (nonatomic, strong) NSDictionary *membersByLocationName;
+@property (nonatomic, strong) NSDictionary *membersByXMLName;
+
+@end
+
+@implementation AWSShape
+
+- (instancetype)initWithShapeID:(NSUInteger)shapeID
+                           name:(NSString *)name
+                          rules:(NSDictionary *)rules {
+    if (self = [super init]) {
+        _shapeID = shapeID;
+        _name = name;
+        _rules = rules;
+        _type = AWSShapeTypeFromString(rules[@"type"]);
+        _payloadMemberName = rules[@"payload"];
+        _requiredMemberNames = rules[@"required"];
+        _min = rules[@"min"];
+        _max = rules[@"max"];
+        _pattern = rules[@"pattern"];
+        _streaming = [rules[@"streaming"] boolValue];
+    }
+    return self;
+}
+
+// Resolves the references to other shapes. It runs once every shape of the model exists, as shapes can refer to
+// each other in cycles.
+- (void)linkWithServiceModel:(AWSServiceModel *)serviceModel {
+    switch (self.type) {
+        case AWSShapeTypeStructure: {
+            NSDictionary *memberRules = self.rules[@"members"];
+            NSArray *memberNames = [[memberRules allKeys] sortedArrayUsingSelector:@selector(compare:)];
+            NSMutableArray *members = [NSMutableArray arrayWithCapacity:[memberNames count]];
+            NSMutableDictionary *membersByName = [NSMutableDictionary dictionaryWithCapacity:[memberNames count]];
+            NSMutableDictionary *membersByLocationName = [NSMutableDictionary dictionaryWithCapacity:[memberNames count]];
+            NSMutableDictionary *membersByXMLName = [NSMutableDictionary dictionaryWithCapacity:[memberNames count]];
+            for (NSString *memberName in memberNames) {
+                AWSShapeMember *member = [[AWSShapeMember alloc] initWithName:memberName
+                                                                        rules:memberRules[memberName]
+                                                                 serviceModel:serviceModel];
+                [members addObject:member];
+                membersByName[memberName] = member;
+                membersByLocationName[member.locationName] = member;
+                membersByXMLName[member.xmlName] = member;
+            }
+            // Elements named after the member itself are accepted as well, as AWSXMLParser always did.
+            for (AWSShapeMember *member in members) {
+                if (!membersByXMLName[member.name]) {
+                    membersByXMLName[member.name] = member;
+                }
+            }
+            self.members = members;
+            self.membersByName = membersByName;
+            self.membersByLocationName = membersByLocationName;
+            self.membersByXMLName = membersByXMLName;
+            break;
+        }
+        case AWSShapeTypeList:
+            self.listMember = [[AWSShapeMember alloc] initWithName:@"member"
+                                                             rules:self.rules[@"member"]
+                                                      serviceModel:serviceModel];
+            break;
+        case AWSShapeTypeMap:
+            self.mapKey = [[AWSShapeMember alloc] initWithName:@"key"
+                                                         rules:self.rules[@"key"]
+                                                  serviceModel:serviceModel];
+            self.mapValue = [[AWSShapeMember alloc] initWithName:@"value"
+                                                           rules:self.rules[@"value"]
+                                                    serviceModel:serviceModel];
+            break;
+        default:
+            break;
+    }
+}
+
+- (AWSShapeMember *)memberNamed:(NSString *)name {
+    return self.membersByName[name];
+}
+
+- (AWSShapeMember *)memberWithLocationName:(NSString *)locationName {
+    return self.membersByLocationName[locationName];
+}
+
+- (AWSShapeMember *)memberWithXMLName:(NSString *)xmlName {
+    return self.membersByXMLName[xmlName];
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p; shapeID = %lu; name = %@>",
+            NSStringFromClass([self class]),
+            self,
+            (unsigned long)self.shapeID,
+            self.name];
+}
+
+@end
+
+@interface AWSServiceModel()
+
+@property (nonatomic, weak) NSDictionary *definition;
+@property (nonatomic, strong) NSArray *shapes;
+@property (nonatomic, strong) NSDictionary *shapesByName;
+
+@end
+
+@implementation AWSServiceModel
+
++ (instancetype)serviceModelWithDefinition:(NSDictionary *)definition {
+    if (!definition) {
+        return nil;
+    }
+
+    // Keyed weakly by the definition, which the model does not retain either, so an entry goes away with its definition.
+    static NSMapTable *serviceModels = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        serviceModels = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality
+                                              valueOptions:NSPointerFunctionsStrongMemory];
+    });
+
+    @synchronized(serviceModels) {
+        AWSServiceModel *serviceModel = [serviceModels objectForKey:definition];
+        if (!serviceModel) {
+            serviceModel = [[AWSServiceModel alloc] initWithDefinition:definition];
+            [serviceModels setObject:serviceModel forKey:definition];
+        }
+        return serviceModel;
+    }
+}
+
+- (instancetype)initWithDefinition:(NSDictionary *)definition {
+    if (self = [super init]) {
+        _definition = definition;
+
+        NSDictionary *shapeRules = definition[@"shapes"];
+        NSArray *shapeNames = [[shapeRules allKeys] sortedArrayUsingSelector:@selector(compare:)];
+        NSMutableArray *shapes = [NSMutableArray arrayWithCapacity:[shapeNames count]];
+        NSMutableDictionary *shapesByName = [NSMutableDictionary dictionaryWithCapacity:[shapeNames count]];
+        for (NSString *shapeName in shapeNames) {
+            AWSShape *shape = [[AWSShape alloc] initWithShapeID:[shapes count]
+                                                           name:shapeName
+                                                          rules:shapeRules[shapeName]];
+            [shapes addObject:shape];
+            shapesByName[shapeName] = shape;
+        }
+        _shapes = shapes;
+        _shapesByName = shapesByName;
+
+        for (AWSShape *shape in shapes) {
+            [shape linkWithServiceModel:self];
+        }
+    }
+    return self;
+}
+
+- (AWSShape *)shapeNamed:(NSString *)name {
+    if (!name) {
+        return nil;
+    }
+    return self.shapesByName[name];
+}
+
+- (AWSShape *)shapeWithID:(NSUInteger)shapeID {
+    if (shapeID >= [self.shapes count]) {
+        return nil;
+    }
+    return self.shapes[shapeID];
+}
+
+- (AWSShape *)inputShapeForOperationName:(NSString *)operationName {
+    return [self shapeNamed:self.definition[@"operations"][operationName][@"input"][@"shape"]];
+}
+
+- (AWSShape *)outputShapeForOperationName:(NSString *)operationName {
+    return [self shapeNamed:self.definition[@"operations"][operationName][@"output"][@"shape"]];
+}
+
+@end
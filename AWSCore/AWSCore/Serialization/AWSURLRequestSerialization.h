@@ -23,6 +23,15 @@
 - (instancetype)initWithJSONDefinition:(NSDictionary *)JSONDefinition
                             actionName:(NSString *)actionName;
 
+/**
+ Encodes the request body straight from the model with `AWSJSONEncoder`, so `serializeRequest:headers:parameters:` does not need the parameters dictionary to build it. The body is encoded right away, before the model can be changed by the caller.
+
+ @param model The request object.
+
+ @return `YES` if the body of the request comes from the model alone. When it returns `NO`, pass the `AWSMTLJSONAdapter` dictionary of the model as the parameters instead.
+ */
+- (BOOL)encodeBodyFromModel:(AWSMTLModel<AWSMTLJSONSerializing> *)model;
+
 @end
 
 @interface AWSXMLRequestSerializer : NSObject <AWSURLRequestSerializer>
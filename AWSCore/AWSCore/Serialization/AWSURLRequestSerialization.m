@@ -20,6 +20,8 @@
 #import "AWSNetworking.h"
 #import "AWSValidation.h"
 #import "AWSSerialization.h"
+#import "AWSServiceModel.h"
+#import "AWSJSONEncoder.h"
 #import "AWSCategory.h"
 #import "AWSLogging.h"
 #import "AWSClientContext.h"
@@ -28,6 +30,8 @@
 
 @property (nonatomic, strong) NSDictionary *serviceDefinitionJSON;
 @property (nonatomic, strong) NSString *actionName;
+@property (nonatomic, strong) NSData *encodedBody;
+@property (nonatomic, strong) NSError *encodingError;
 
 @end
 
@@ -48,11 +52,29 @@
     return self;
 }
 
+- (BOOL)encodeBodyFromModel:(AWSMTLModel<AWSMTLJSONSerializing> *)model {
+    AWSServiceModel *serviceModel = [AWSServiceModel serviceModelWithDefinition:self.serviceDefinitionJSON];
+    AWSShape *inputShape = [serviceModel inputShapeForOperationName:self.actionName];
+    // Members bound to the URI or headers still need the parameters dictionary.
+    if (!inputShape || ![AWSJSONEncoder canEncodeShape:inputShape]) {
+        return NO;
+    }
+
+    NSError *error = nil;
+    self.encodedBody = [AWSJSONEncoder JSONDataForModel:model shape:inputShape error:&error];
+    self.encodingError = error;
+    return YES;
+}
+
 - (AWSTask *)serializeRequest:(NSMutableURLRequest *)request
                      headers:(NSDictionary *)headers
                   parameters:(NSDictionary *)parameters {
     request.cachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
 
+    if (self.encodingError) {
+        return [AWSTask taskWithError:self.encodingError];
+    }
+
     //If parameters contains clientContext key, move it to http header. This is a sepcial case
     if ([parameters objectForKey:@"clientContext"]) {
         [request setValue:[[[parameters objectForKey:@"clientContext"] dataUsingEncoding:NSUTF8StringEncoding] base64EncodedStringWithOptions:kNilOptions]
@@ -84,7 +106,10 @@
     
     //construct HTTPBody only if HTTPBodyStream is nil
     if (!request.HTTPBodyStream) {
-        NSData *bodyData = [AWSJSONBuilder jsonDataForDictionary:parameters actionName:self.actionName serviceDefinitionRule:self.serviceDefinitionJSON error:&error];
+        NSData *bodyData = self.encodedBody;
+        if (!bodyData) {
+            bodyData = [AWSJSONBuilder jsonDataForDictionary:parameters actionName:self.actionName serviceDefinitionRule:self.serviceDefinitionJSON error:&error];
+        }
         if (!error) {
             if ([request.HTTPMethod isEqualToString:@"GET"]) {
                 //GET request should be have any body. aws lambda server will close connection if that is the case.
@@ -313,6 +338,13 @@
                         *stop = YES;
                     }
 
+                } else if ([value isKindOfClass:[NSInputStream class]]) {
+                    //a stream can be read only once. use a fresh copy when possible so that the request can be retried.
+                    if ([value conformsToProtocol:@protocol(NSCopying)]) {
+                        request.HTTPBodyStream = [value copy];
+                    } else {
+                        request.HTTPBodyStream = value;
+                    }
                 } else {
                     if ([value isKindOfClass:[NSString class]]) {
                         value = [value dataUsingEncoding:NSUTF8StringEncoding];
@@ -20,6 +20,9 @@
 #import "AWSService.h"
 #import "AWSValidation.h"
 #import "AWSSerialization.h"
+#import "AWSServiceModel.h"
+#import "AWSJSONDecoder.h"
+#import "AWSXMLDecoder.h"
 
 NSString *const AWSGeneralErrorDomain = @"com.amazonaws.AWSGeneralErrorDomain";
 
@@ -65,6 +68,27 @@ static NSDictionary *errorCodeDictionary = nil;
     return self;
 }
 
+- (id<AWSHTTPURLResponseDecoder>)responseDecoderForResponse:(NSHTTPURLResponse *)response {
+    //Only successful responses of the json protocol are decoded as they arrive. Error responses are parsed and checked
+    //as a whole, and the body is kept when it is to be logged.
+    if (!self.outputClass
+        || response.statusCode / 100 != 2
+        || [AWSLogger defaultLogger].logLevel >= AWSLogLevelVerbose
+        || [[[response allHeaderFields] objectForKey:@"Content-Type"] rangeOfString:@"text/html"].location != NSNotFound) {
+        return nil;
+    }
+
+    AWSServiceModel *serviceModel = [AWSServiceModel serviceModelWithDefinition:self.serviceDefinitionJSON];
+    if (![serviceModel.definition[@"metadata"][@"protocol"] isEqualToString:@"json"]) {
+        return nil;
+    }
+    AWSShape *outputShape = [serviceModel outputShapeForOperationName:self.actionName];
+    if (![AWSJSONDecoder canDecodeShape:outputShape modelClass:self.outputClass]) {
+        return nil;
+    }
+    return [[AWSJSONDecoder alloc] initWithShape:outputShape modelClass:self.outputClass];
+}
+
 - (id)responseObjectForResponse:(NSHTTPURLResponse *)response
                 originalRequest:(NSURLRequest *)originalRequest
                  currentRequest:(NSURLRequest *)currentRequest
@@ -74,6 +98,11 @@ static NSDictionary *errorCodeDictionary = nil;
         AWSLogDebug(@"Response header: [%@]", response.allHeaderFields);
     }
 
+    //The body has already been decoded into the output model while it was received.
+    if ([data isKindOfClass:[AWSJSONDecoder class]]) {
+        return [data decodedModelWithError:error];
+    }
+
     if ([data isKindOfClass:[NSData class]]) {
         AWSLogVerbose(@"Response body: [%@]", [[NSString alloc] initWithData:data
                                                                     encoding:NSUTF8StringEncoding]);
@@ -172,6 +201,31 @@ static NSDictionary *errorCodeDictionary = nil;
     return self;
 }
 
+- (id<AWSHTTPURLResponseDecoder>)responseDecoderForResponse:(NSHTTPURLResponse *)response {
+    //Only successful responses are decoded as they arrive, as with AWSJSONResponseSerializer. Outputs with members in
+    //the headers or with a payload are left to AWSXMLParser.
+    if (!self.outputClass
+        || response.statusCode / 100 != 2
+        || [AWSLogger defaultLogger].logLevel >= AWSLogLevelVerbose
+        || [[[response allHeaderFields] objectForKey:@"Content-Type"] rangeOfString:@"text/html"].location != NSNotFound) {
+        return nil;
+    }
+
+    AWSServiceModel *serviceModel = [AWSServiceModel serviceModelWithDefinition:self.serviceDefinitionJSON];
+    NSDictionary *metadata = serviceModel.definition[@"metadata"];
+    NSString *protocol = metadata[@"type"] ?: metadata[@"protocol"];
+    if (![@[@"query", @"rest-xml", @"ec2"] containsObject:protocol]) {
+        return nil;
+    }
+    AWSShape *outputShape = [serviceModel outputShapeForOperationName:self.actionName];
+    if (![AWSXMLDecoder canDecodeShape:outputShape modelClass:self.outputClass]) {
+        return nil;
+    }
+    return [[AWSXMLDecoder alloc] initWithServiceModel:serviceModel
+                                         operationName:self.actionName
+                                            modelClass:self.outputClass];
+}
+
 - (BOOL)validateResponse:(NSHTTPURLResponse *)response
              fromRequest:(NSURLRequest *)request
                     data:(id)data
@@ -297,6 +351,16 @@ static NSDictionary *errorCodeDictionary = nil;
         }
     }
 
+    if ([data isKindOfClass:[AWSXMLDecoder class]]) {
+        //The body has already been decoded into the output model while it was received. An error document is
+        //returned as a dictionary and checked below.
+        id decodedObject = [data decodedModelWithError:error];
+        if (![decodedObject isKindOfClass:[NSDictionary class]]) {
+            return decodedObject;
+        }
+        resultDic = decodedObject;
+    }
+
     if ([resultDic count] == 0) {
         //if not blob type, try to parse as XML string
         resultDic = [[AWSXMLParser sharedInstance] dictionaryForXMLData:data
@@ -0,0 +1,61 @@
+/*
+ Copyright 2010-2015 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License").
+ You may not use this file except in compliance with the License.
+ A copy of the License is located at
+
+ http://aws.amazon.com/apache2.0
+
+ or in the "license" file accompanying this file. This file is distributed
+ on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ express or implied. See the License for the specific language governing
+ permissions and limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+#import "AWSNetworking.h"
+
+@class AWSShape;
+@class AWSServiceModel;
+
+/**
+ Builds the output model of an operation from its XML response in a single pass, guided by the compiled shape of the
+ output. The body can be appended in pieces as it arrives, and each piece is tokenized right away. It produces the same
+ model as `AWSXMLParser` followed by `AWSMTLJSONAdapter`, without building the dictionary tree of the document.
+
+ The tokenizer covers what AWS services send: UTF-8 elements and text with the predefined entities, character
+ references and CDATA sections. Attributes are ignored, as with `AWSXMLParser`, and the XML declaration, comments,
+ processing instructions and DOCTYPE are skipped.
+ */
+@interface AWSXMLDecoder : NSObject <AWSHTTPURLResponseDecoder>
+
+/**
+ Returns whether responses of the given output shape can be decoded into models of the given class.
+ */
++ (BOOL)canDecodeShape:(AWSShape *)shape
+            modelClass:(Class)modelClass;
+
+/**
+ Returns a decoder for the output of an operation. The protocol of the service decides where the output is found in
+ the document: query results are unwrapped from their result element, and a rest-xml document may consist of a single
+ member of the output.
+ */
+- (instancetype)initWithServiceModel:(AWSServiceModel *)serviceModel
+                       operationName:(NSString *)operationName
+                          modelClass:(Class)modelClass;
+
+/**
+ Decodes the next piece of the body. Once the body is found to be invalid, the rest of it is ignored.
+ */
+- (void)appendData:(NSData *)data;
+
+/**
+ Returns the model decoded from the whole body. A document whose root is `Error`, which S3 may send with a successful
+ status, is returned as `@{@"Error" : ...}`, the dictionary `AWSXMLParser` makes of it.
+ @param error On failure, an error in `NSXMLParserErrorDomain` when the body is not well-formed XML, or in
+              `AWSXMLParserErrorDomain` when the model cannot be created.
+ */
+- (id)decodedModelWithError:(NSError *__autoreleasing *)error;
+
+@end
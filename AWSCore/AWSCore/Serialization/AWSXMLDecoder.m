@@ -0,0 +1,826 @@
+/*
+ Copyright 2010-2015 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License").
+ You may not use this file except in compliance with the License.
+ A copy of the License is located at
+
+ http://aws.amazon.com/apache2.0
+
+ or in the "license" file accompanying this file. This file is distributed
+ on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ express or implied. See the License for the specific language governing
+ permissions and limitations under the License.
+ */
+
+#import "AWSXMLDecoder.h"
+
+#import "AWSMantle.h"
+#import "AWSCategory.h"
+#import "AWSSerialization.h"
+#import "AWSServiceModel.h"
+#import "AWSJSONModelMetadata.h"
+
+typedef NS_ENUM(NSInteger, AWSXMLDecoderState) {
+    AWSXMLDecoderStateText,
+    AWSXMLDecoderStateMarkup,
+};
+
+typedef NS_ENUM(NSInteger, AWSXMLDecoderMarkupType) {
+    AWSXMLDecoderMarkupUnknown,
+    AWSXMLDecoderMarkupTag,
+    AWSXMLDecoderMarkupComment,
+    AWSXMLDecoderMarkupCDATA,
+    AWSXMLDecoderMarkupProcessingInstruction,
+    AWSXMLDecoderMarkupDeclaration,
+};
+
+typedef NS_ENUM(NSInteger, AWSXMLDecoderFrameKind) {
+    AWSXMLDecoderFrameStructure,
+    AWSXMLDecoderFrameList,
+    AWSXMLDecoderFrameMap,
+    AWSXMLDecoderFrameMapEntry,
+    AWSXMLDecoderFrameScalar,
+    // An element of an error document, kept as AWSXMLDictionaryParser would.
+    AWSXMLDecoderFrameGeneric,
+};
+
+// Where the value of a frame goes once its element ends.
+typedef NS_ENUM(NSInteger, AWSXMLDecoderFrameRole) {
+    AWSXMLDecoderFrameRoleDocument,
+    AWSXMLDecoderFrameRoleResult,
+    AWSXMLDecoderFrameRoleMember,
+    AWSXMLDecoderFrameRoleListItem,
+    AWSXMLDecoderFrameRoleMapEntry,
+    AWSXMLDecoderFrameRoleMapKey,
+    AWSXMLDecoderFrameRoleMapValue,
+    AWSXMLDecoderFrameRoleGenericChild,
+};
+
+// An element being decoded.
+@interface AWSXMLDecoderFrame : NSObject
+
+@property (nonatomic, strong) NSString *elementName;
+@property (nonatomic, assign) AWSXMLDecoderFrameKind kind;
+@property (nonatomic, assign) AWSXMLDecoderFrameRole role;
+@property (nonatomic, strong) AWSShape *shape;
+// The member describing the value of the element, for the timestamp format of scalars.
+@property (nonatomic, strong) AWSShapeMember *member;
+// The member of the parent structure the element belongs to, and the property it is stored in.
+@property (nonatomic, strong) AWSShapeMember *structureMember;
+@property (nonatomic, strong) NSString *propertyKey;
+@property (nonatomic, strong) AWSJSONModelMetadata *metadata;
+// The property values of a structure, the entries of a map, or the children of a generic element.
+@property (nonatomic, strong) NSMutableDictionary *values;
+@property (nonatomic, strong) NSMutableArray *elements;
+@property (nonatomic, strong) id entryKey;
+@property (nonatomic, strong) id entryValue;
+
+@end
+
+@implementation AWSXMLDecoderFrame
+
+@end
+
+static BOOL AWSXMLDecoderIsWhitespace(uint8_t c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static void AWSXMLDecoderAppendCodePoint(NSMutableData *data, uint32_t codePoint) {
+    uint8_t buffer[4];
+    NSUInteger length = 0;
+    if (codePoint < 0x80) {
+        buffer[length++] = codePoint;
+    } else if (codePoint < 0x800) {
+        buffer[length++] = 0xC0 | (codePoint >> 6);
+        buffer[length++] = 0x80 | (codePoint & 0x3F);
+    } else if (codePoint < 0x10000) {
+        buffer[length++] = 0xE0 | (codePoint >> 12);
+        buffer[length++] = 0x80 | ((codePoint >> 6) & 0x3F);
+        buffer[length++] = 0x80 | (codePoint & 0x3F);
+    } else {
+        buffer[length++] = 0xF0 | (codePoint >> 18);
+        buffer[length++] = 0x80 | ((codePoint >> 12) & 0x3F);
+        buffer[length++] = 0x80 | ((codePoint >> 6) & 0x3F);
+        buffer[length++] = 0x80 | (codePoint & 0x3F);
+    }
+    [data appendBytes:buffer length:length];
+}
+
+// Resolves a reference between '&' and ';'. Returns NO for references XML does not predefine.
+static BOOL AWSXMLDecoderAppendReference(NSMutableData *data, const uint8_t *name, NSUInteger length) {
+    if (length >= 2 && name[0] == '#') {
+        BOOL isHex = name[1] == 'x';
+        NSUInteger i = isHex ? 2 : 1;
+        if (i >= length) {
+            return NO;
+        }
+        uint32_t codePoint = 0;
+        for (; i < length; i++) {
+            uint8_t c = name[i];
+            uint32_t digit = 0;
+            if (c >= '0' && c <= '9') {
+                digit = c - '0';
+            } else if (isHex && c >= 'a' && c <= 'f') {
+                digit = c - 'a' + 10;
+            } else if (isHex && c >= 'A' && c <= 'F') {
+                digit = c - 'A' + 10;
+            } else {
+                return NO;
+            }
+            codePoint = codePoint * (isHex ? 16 : 10) + digit;
+            if (codePoint > 0x10FFFF) {
+                return NO;
+            }
+        }
+        if (codePoint == 0 || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) {
+            return NO;
+        }
+        AWSXMLDecoderAppendCodePoint(data, codePoint);
+        return YES;
+    }
+
+    static const struct {
+        const char *name;
+        uint8_t character;
+    } entities[] = {{"lt", '<'}, {"gt", '>'}, {"amp", '&'}, {"quot", '"'}, {"apos", '\''}};
+    for (NSUInteger i = 0; i < sizeof(entities) / sizeof(entities[0]); i++) {
+        if (strlen(entities[i].name) == length && memcmp(entities[i].name, name, length) == 0) {
+            [data appendBytes:&entities[i].character length:1];
+            return YES;
+        }
+    }
+    return NO;
+}
+
+// Returns the string of a run of text with references in it. References that cannot be resolved are kept as they are.
+static NSString *AWSXMLDecoderUnescapedString(const uint8_t *bytes, NSUInteger length) {
+    NSMutableData *data = [NSMutableData dataWithCapacity:length];
+    NSUInteger runStart = 0;
+    NSUInteger i = 0;
+    while (i < length) {
+        if (bytes[i] != '&') {
+            i++;
+            continue;
+        }
+        const uint8_t *semicolon = memchr(bytes + i + 1, ';', length - i - 1);
+        if (!semicolon) {
+            break;
+        }
+        NSUInteger end = semicolon - bytes;
+        [data appendBytes:bytes + runStart length:i - runStart];
+        if (!AWSXMLDecoderAppendReference(data, bytes + i + 1, end - i - 1)) {
+            [data appendBytes:bytes + i length:end + 1 - i];
+        }
+        i = end + 1;
+        runStart = i;
+    }
+    [data appendBytes:bytes + runStart length:length - runStart];
+    return [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+}
+
+@interface AWSXMLDecoder()
+
+@property (nonatomic, strong) AWSShape *shape;
+@property (nonatomic, assign) Class modelClass;
+@property (nonatomic, strong) AWSJSONModelShapeMapping *mapping;
+// The elements a query result may be wrapped in.
+@property (nonatomic, strong) NSArray *resultWrapperNames;
+@property (nonatomic, assign) BOOL rootMayBeMember;
+@property (nonatomic, strong) NSMutableArray *frames;
+// The depth of the elements being skipped, which need no frames.
+@property (nonatomic, assign) NSUInteger skipDepth;
+@property (nonatomic, assign) AWSXMLDecoderState state;
+@property (nonatomic, assign) AWSXMLDecoderMarkupType markupType;
+@property (nonatomic, strong) NSMutableData *markupData;
+@property (nonatomic, assign) NSUInteger markupLength;
+// The last bytes of the markup, to find the end of comments, CDATA sections and processing instructions.
+@property (nonatomic, assign) uint64_t markupTail;
+@property (nonatomic, assign) uint8_t markupQuote;
+@property (nonatomic, assign) NSUInteger markupBracketDepth;
+// The text of the current element: what is resolved so far, and the run still being received.
+@property (nonatomic, strong) NSString *text;
+@property (nonatomic, strong) NSMutableData *textData;
+@property (nonatomic, assign) BOOL textHasReferences;
+@property (nonatomic, assign) NSUInteger decodedLength;
+@property (nonatomic, strong) id resultModel;
+@property (nonatomic, strong) id rootValue;
+@property (nonatomic, strong) NSError *error;
+
+@end
+
+@implementation AWSXMLDecoder
+
++ (BOOL)canDecodeShape:(AWSShape *)shape
+            modelClass:(Class)modelClass {
+    if (shape.type != AWSShapeTypeStructure || shape.payloadMemberName) {
+        return NO;
+    }
+    for (AWSShapeMember *member in shape.members) {
+        if (member.location != AWSShapeMemberLocationBody) {
+            return NO;
+        }
+    }
+    return [AWSJSONModelShapeMapping mappingForShape:shape modelClass:modelClass] != nil;
+}
+
+- (instancetype)initWithServiceModel:(AWSServiceModel *)serviceModel
+                       operationName:(NSString *)operationName
+                          modelClass:(Class)modelClass {
+    if (self = [super init]) {
+        _shape = [serviceModel outputShapeForOperationName:operationName];
+        _mapping = [AWSJSONModelShapeMapping mappingForShape:_shape modelClass:modelClass];
+        if (!_mapping) {
+            return nil;
+        }
+        _modelClass = modelClass;
+
+        // The same unwrapping as +[AWSXMLParser preprocessDictionary:operationName:actionRule:serviceDefinitionRule:].
+        NSDictionary *metadata = serviceModel.definition[@"metadata"];
+        NSString *protocol = metadata[@"type"] ?: metadata[@"protocol"];
+        NSNumber *isResultWrapped = metadata[@"resultWrapped"];
+        if ([protocol isEqualToString:@"query"] && !(isResultWrapped && ![isResultWrapped boolValue])) {
+            NSMutableArray *resultWrapperNames = [NSMutableArray arrayWithCapacity:2];
+            NSString *resultWrapper = serviceModel.definition[@"operations"][operationName][@"output"][@"resultWrapper"];
+            if ([resultWrapper isKindOfClass:[NSString class]]) {
+                [resultWrapperNames addObject:resultWrapper];
+            }
+            [resultWrapperNames addObject:[operationName stringByAppendingString:@"Result"]];
+            _resultWrapperNames = resultWrapperNames;
+        }
+        _rootMayBeMember = [protocol isEqualToString:@"rest-xml"];
+
+        _frames = [NSMutableArray new];
+        _markupData = [NSMutableData new];
+        _textData = [NSMutableData new];
+        _state = AWSXMLDecoderStateText;
+    }
+    return self;
+}
+
+#pragma mark - Errors
+
+- (BOOL)failWithCode:(NSInteger)code description:(NSString *)description {
+    self.error = [NSError errorWithDomain:AWSXMLParserErrorDomain
+                                     code:code
+                                 userInfo:@{NSLocalizedDescriptionKey : description}];
+    return NO;
+}
+
+- (BOOL)failWithSyntaxError:(NSXMLParserError)code {
+    if (!self.error) {
+        self.error = [NSError errorWithDomain:NSXMLParserErrorDomain
+                                         code:code
+                                     userInfo:@{NSLocalizedDescriptionKey : [NSString stringWithFormat:@"Invalid XML around byte %lu.", (unsigned long)self.decodedLength]}];
+    }
+    return NO;
+}
+
+#pragma mark - Tokenizing
+
+- (void)appendData:(NSData *)data {
+    [data enumerateByteRangesUsingBlock:^(const void *bytes, NSRange byteRange, BOOL *stop) {
+        if (![self decodeBytes:bytes length:byteRange.length]) {
+            *stop = YES;
+        }
+    }];
+}
+
+- (BOOL)decodeBytes:(const uint8_t *)bytes length:(NSUInteger)length {
+    if (self.error) {
+        return NO;
+    }
+
+    NSUInteger i = 0;
+    while (i < length) {
+        switch (self.state) {
+            case AWSXMLDecoderStateText: {
+                // Copies everything up to the next markup at once. References are resolved when the run ends.
+                const uint8_t *markup = memchr(bytes + i, '<', length - i);
+                NSUInteger end = markup ? markup - bytes : length;
+                if (end > i && [self isCollectingText]) {
+                    [self.textData appendBytes:bytes + i length:end - i];
+                    if (memchr(bytes + i, '&', end - i)) {
+                        self.textHasReferences = YES;
+                    }
+                }
+                self.decodedLength += end - i;
+                i = end;
+                if (markup) {
+                    if (![self endTextRun]) {
+                        return NO;
+                    }
+                    i++;
+                    self.decodedLength++;
+                    self.state = AWSXMLDecoderStateMarkup;
+                    self.markupType = AWSXMLDecoderMarkupUnknown;
+                    self.markupLength = 0;
+                    self.markupTail = 0;
+                    self.markupQuote = 0;
+                    self.markupBracketDepth = 0;
+                    [self.markupData setLength:0];
+                }
+                break;
+            }
+
+            case AWSXMLDecoderStateMarkup: {
+                NSUInteger start = i;
+                BOOL ended = NO;
+                AWSXMLDecoderMarkupType type = self.markupType;
+                NSUInteger markupLength = self.markupLength;
+                uint64_t tail = self.markupTail;
+                while (i < length && !ended) {
+                    uint8_t c = bytes[i++];
+                    markupLength++;
+                    tail = (tail << 8) | c;
+                    switch (type) {
+                        case AWSXMLDecoderMarkupUnknown:
+                            if (markupLength == 1) {
+                                if (c == '?') {
+                                    type = AWSXMLDecoderMarkupProcessingInstruction;
+                                } else if (c != '!') {
+                                    type = AWSXMLDecoderMarkupTag;
+                                    ended = c == '>';
+                                }
+                            } else {
+                                // After "<!", the markup is a comment or a CDATA section once its whole prefix is
+                                // read, and a declaration as soon as it departs from both.
+                                uint8_t second = (tail >> ((markupLength - 2) * 8)) & 0xFF;
+                                const char *prefix = second == '-' ? "!--" : (second == '[' ? "![CDATA[" : NULL);
+                                if (!prefix || c != (uint8_t)prefix[markupLength - 1]) {
+                                    type = AWSXMLDecoderMarkupDeclaration;
+                                    ended = c == '>';
+                                } else if (markupLength == strlen(prefix)) {
+                                    type = second == '-' ? AWSXMLDecoderMarkupComment : AWSXMLDecoderMarkupCDATA;
+                                }
+                            }
+                            break;
+                        case AWSXMLDecoderMarkupTag:
+                            if (self.markupQuote) {
+                                if (c == self.markupQuote) {
+                                    self.markupQuote = 0;
+                                }
+                            } else if (c == '"' || c == '\'') {
+                                self.markupQuote = c;
+                            } else if (c == '>') {
+                                ended = YES;
+                            }
+                            break;
+                        case AWSXMLDecoderMarkupComment:
+                            ended = markupLength >= 6 && (tail & 0xFFFFFF) == ((uint64_t)'-' << 16 | '-' << 8 | '>');
+                            break;
+                        case AWSXMLDecoderMarkupCDATA:
+                            ended = markupLength >= 11 && (tail & 0xFFFFFF) == ((uint64_t)']' << 16 | ']' << 8 | '>');
+                            break;
+                        case AWSXMLDecoderMarkupProcessingInstruction:
+                            ended = markupLength >= 3 && (tail & 0xFFFF) == ('?' << 8 | '>');
+                            break;
+                        case AWSXMLDecoderMarkupDeclaration:
+                            if (c == '[') {
+                                self.markupBracketDepth++;
+                            } else if (c == ']' && self.markupBracketDepth > 0) {
+                                self.markupBracketDepth--;
+                            } else if (c == '>' && self.markupBracketDepth == 0) {
+                                ended = YES;
+                            }
+                            break;
+                    }
+                }
+                // Only tags and CDATA sections are read, so the rest of the markup is not kept.
+                if (type == AWSXMLDecoderMarkupUnknown || type == AWSXMLDecoderMarkupTag || type == AWSXMLDecoderMarkupCDATA) {
+                    [self.markupData appendBytes:bytes + start length:i - start];
+                }
+                self.markupType = type;
+                self.markupLength = markupLength;
+                self.markupTail = tail;
+                self.decodedLength += i - start;
+                if (ended) {
+                    self.state = AWSXMLDecoderStateText;
+                    if (![self endMarkup]) {
+                        return NO;
+                    }
+                }
+                break;
+            }
+        }
+    }
+    return YES;
+}
+
+- (BOOL)isCollectingText {
+    if (self.skipDepth > 0) {
+        return NO;
+    }
+    AWSXMLDecoderFrame *frame = [self.frames lastObject];
+    return frame.kind == AWSXMLDecoderFrameScalar || frame.kind == AWSXMLDecoderFrameGeneric;
+}
+
+- (BOOL)appendText:(NSString *)string {
+    if (!string) {
+        return [self failWithSyntaxError:NSXMLParserInvalidCharacterError];
+    }
+    self.text = self.text ? [self.text stringByAppendingString:string] : string;
+    return YES;
+}
+
+- (BOOL)endTextRun {
+    NSUInteger length = [self.textData length];
+    if (length == 0) {
+        return YES;
+    }
+    NSString *string = nil;
+    if (self.textHasReferences) {
+        string = AWSXMLDecoderUnescapedString([self.textData bytes], length);
+    } else {
+        string = [[NSString alloc] initWithData:self.textData encoding:NSUTF8StringEncoding];
+    }
+    [self.textData setLength:0];
+    self.textHasReferences = NO;
+    return [self appendText:string];
+}
+
+- (BOOL)endMarkup {
+    const uint8_t *bytes = [self.markupData bytes];
+    // Leaves out the closing '>'.
+    NSUInteger length = [self.markupData length] - 1;
+
+    switch (self.markupType) {
+        case AWSXMLDecoderMarkupCDATA:
+            if (![self isCollectingText]) {
+                return YES;
+            }
+            // Leaves out "![CDATA[" and "]]".
+            return [self appendText:[[NSString alloc] initWithBytes:bytes + 8
+                                                             length:length - 10
+                                                           encoding:NSUTF8StringEncoding]];
+        case AWSXMLDecoderMarkupTag: {
+            BOOL isEndTag = bytes[0] == '/';
+            BOOL isEmptyElement = !isEndTag && length > 0 && bytes[length - 1] == '/';
+            NSUInteger nameStart = isEndTag ? 1 : 0;
+            NSUInteger nameEnd = nameStart;
+            while (nameEnd < length && !AWSXMLDecoderIsWhitespace(bytes[nameEnd]) && bytes[nameEnd] != '/') {
+                nameEnd++;
+            }
+            if (nameEnd == nameStart) {
+                return [self failWithSyntaxError:NSXMLParserNAMERequiredError];
+            }
+            NSString *name = [[NSString alloc] initWithBytes:bytes + nameStart
+                                                      length:nameEnd - nameStart
+                                                    encoding:NSUTF8StringEncoding];
+            if (!name) {
+                return [self failWithSyntaxError:NSXMLParserInvalidCharacterError];
+            }
+            if (isEndTag) {
+                return [self endElement:name];
+            }
+            return [self startElement:name] && (!isEmptyElement || [self endElement:name]);
+        }
+        default:
+            return YES;
+    }
+}
+
+#pragma mark - Decoding
+
+- (AWSXMLDecoderFrame *)frameForMember:(AWSShapeMember *)member {
+    AWSXMLDecoderFrame *frame = [AWSXMLDecoderFrame new];
+    frame.member = member;
+    frame.shape = member.shape;
+    switch (member.shape.type) {
+        case AWSShapeTypeStructure:
+            frame.kind = AWSXMLDecoderFrameStructure;
+            frame.metadata = [self.mapping metadataForShape:member.shape];
+            frame.values = [NSMutableDictionary new];
+            break;
+        case AWSShapeTypeList:
+            frame.kind = AWSXMLDecoderFrameList;
+            frame.elements = [NSMutableArray new];
+            break;
+        case AWSShapeTypeMap:
+            frame.kind = AWSXMLDecoderFrameMap;
+            frame.values = [NSMutableDictionary new];
+            break;
+        default:
+            frame.kind = AWSXMLDecoderFrameScalar;
+            break;
+    }
+    return frame;
+}
+
+- (AWSXMLDecoderFrame *)frameForStructureShape:(AWSShape *)shape {
+    AWSXMLDecoderFrame *frame = [AWSXMLDecoderFrame new];
+    frame.kind = AWSXMLDecoderFrameStructure;
+    frame.shape = shape;
+    frame.metadata = [self.mapping metadataForShape:shape];
+    frame.values = [NSMutableDictionary new];
+    return frame;
+}
+
+- (AWSXMLDecoderFrame *)entryFrameForMapShape:(AWSShape *)shape {
+    AWSXMLDecoderFrame *frame = [AWSXMLDecoderFrame new];
+    frame.kind = AWSXMLDecoderFrameMapEntry;
+    frame.shape = shape;
+    return frame;
+}
+
+// The frame of a child element, or nil if the element is to be skipped.
+- (AWSXMLDecoderFrame *)frameForElement:(NSString *)name parent:(AWSXMLDecoderFrame *)parent {
+    AWSXMLDecoderFrame *frame = nil;
+    switch (parent.kind) {
+        case AWSXMLDecoderFrameStructure: {
+            if (parent.role == AWSXMLDecoderFrameRoleDocument && [self.resultWrapperNames containsObject:name]) {
+                frame = [self frameForStructureShape:self.shape];
+                frame.role = AWSXMLDecoderFrameRoleResult;
+                break;
+            }
+            // Elements the model has no property for are skipped, as AWSXMLParser does.
+            AWSShapeMember *member = [parent.shape memberWithXMLName:name];
+            NSString *propertyKey = member ? parent.metadata.propertyKeysByJSONKey[member.name] : nil;
+            if (!propertyKey) {
+                return nil;
+            }
+            // The elements of a flattened list or map are repeated directly in the structure, one for each entry.
+            if (member.isFlattened && member.shape.type == AWSShapeTypeList) {
+                frame = [self frameForMember:member.shape.listMember];
+            } else if (member.isFlattened && member.shape.type == AWSShapeTypeMap) {
+                frame = [self entryFrameForMapShape:member.shape];
+            } else {
+                frame = [self frameForMember:member];
+            }
+            frame.role = AWSXMLDecoderFrameRoleMember;
+            frame.structureMember = member;
+            frame.propertyKey = propertyKey;
+            break;
+        }
+        case AWSXMLDecoderFrameList:
+            if ([name isEqualToString:parent.shape.listMember.locationName]) {
+                frame = [self frameForMember:parent.shape.listMember];
+                frame.role = AWSXMLDecoderFrameRoleListItem;
+            }
+            break;
+        case AWSXMLDecoderFrameMap:
+            if ([name isEqualToString:@"entry"]) {
+                frame = [self entryFrameForMapShape:parent.shape];
+                frame.role = AWSXMLDecoderFrameRoleMapEntry;
+            }
+            break;
+        case AWSXMLDecoderFrameMapEntry:
+            if ([name isEqualToString:parent.shape.mapKey.locationName]) {
+                frame = [self frameForMember:parent.shape.mapKey];
+                frame.role = AWSXMLDecoderFrameRoleMapKey;
+            } else if ([name isEqualToString:parent.shape.mapValue.locationName]) {
+                frame = [self frameForMember:parent.shape.mapValue];
+                frame.role = AWSXMLDecoderFrameRoleMapValue;
+            }
+            break;
+        case AWSXMLDecoderFrameGeneric:
+            frame = [AWSXMLDecoderFrame new];
+            frame.kind = AWSXMLDecoderFrameGeneric;
+            frame.role = AWSXMLDecoderFrameRoleGenericChild;
+            if (!parent.values) {
+                parent.values = [NSMutableDictionary new];
+            }
+            break;
+        case AWSXMLDecoderFrameScalar:
+            break;
+    }
+    return frame;
+}
+
+- (BOOL)startElement:(NSString *)name {
+    if (self.skipDepth > 0) {
+        self.skipDepth++;
+        return YES;
+    }
+    // Text before a child element is not part of any value.
+    self.text = nil;
+
+    AWSXMLDecoderFrame *parent = [self.frames lastObject];
+    if (!parent) {
+        if (self.rootValue) {
+            return [self failWithSyntaxError:NSXMLParserExtraContentError];
+        }
+        if ([name isEqualToString:@"Error"]) {
+            AWSXMLDecoderFrame *frame = [AWSXMLDecoderFrame new];
+            frame.kind = AWSXMLDecoderFrameGeneric;
+            frame.role = AWSXMLDecoderFrameRoleDocument;
+            frame.elementName = name;
+            [self.frames addObject:frame];
+            return YES;
+        }
+
+        AWSXMLDecoderFrame *document = [self frameForStructureShape:self.shape];
+        document.role = AWSXMLDecoderFrameRoleDocument;
+        [self.frames addObject:document];
+        // A rest-xml document may be a single scalar member, such as the LocationConstraint of GetBucketLocation.
+        // The document then has no element of its own.
+        AWSShapeMember *member = self.rootMayBeMember ? [self.shape memberWithXMLName:name] : nil;
+        AWSXMLDecoderFrame *frame = member ? [self frameForElement:name parent:document] : nil;
+        if (frame.kind != AWSXMLDecoderFrameScalar) {
+            document.elementName = name;
+            return YES;
+        }
+        frame.elementName = name;
+        [self.frames addObject:frame];
+        return YES;
+    }
+
+    AWSXMLDecoderFrame *frame = [self frameForElement:name parent:parent];
+    if (!frame) {
+        self.skipDepth = 1;
+        return YES;
+    }
+    frame.elementName = name;
+    [self.frames addObject:frame];
+    return YES;
+}
+
+- (BOOL)endElement:(NSString *)name {
+    if (self.skipDepth > 0) {
+        self.skipDepth--;
+        return YES;
+    }
+
+    AWSXMLDecoderFrame *frame = [self.frames lastObject];
+    if (![frame.elementName isEqualToString:name]) {
+        return [self failWithSyntaxError:NSXMLParserTagNameMismatchError];
+    }
+    [self.frames removeLastObject];
+    if (![self endFrame:frame]) {
+        return NO;
+    }
+    self.text = nil;
+
+    // Ends a document that has no element of its own along with its only member.
+    AWSXMLDecoderFrame *document = [self.frames lastObject];
+    if ([self.frames count] == 1 && !document.elementName) {
+        [self.frames removeLastObject];
+        return [self endFrame:document];
+    }
+    return YES;
+}
+
+- (BOOL)endFrame:(AWSXMLDecoderFrame *)frame {
+    id value = nil;
+    switch (frame.kind) {
+        case AWSXMLDecoderFrameStructure:
+            value = [self modelForFrame:frame];
+            if (!value) {
+                return NO;
+            }
+            break;
+        case AWSXMLDecoderFrameList:
+            value = frame.elements;
+            break;
+        case AWSXMLDecoderFrameMap:
+            value = frame.values;
+            break;
+        case AWSXMLDecoderFrameMapEntry:
+            break;
+        case AWSXMLDecoderFrameScalar:
+            value = [self scalarWithText:self.text ?: @"" member:frame.member];
+            break;
+        case AWSXMLDecoderFrameGeneric:
+            value = frame.values ?: (self.text ?: @"");
+            break;
+    }
+
+    AWSXMLDecoderFrame *parent = [self.frames lastObject];
+    switch (frame.role) {
+        case AWSXMLDecoderFrameRoleDocument:
+            if (frame.kind == AWSXMLDecoderFrameGeneric) {
+                self.rootValue = [NSMutableDictionary dictionaryWithObject:value forKey:frame.elementName];
+            } else {
+                self.rootValue = self.resultModel ?: value;
+            }
+            break;
+        case AWSXMLDecoderFrameRoleResult:
+            self.resultModel = value;
+            break;
+        case AWSXMLDecoderFrameRoleMember: {
+            AWSShapeMember *member = frame.structureMember;
+            if (member.isFlattened && member.shape.type == AWSShapeTypeList) {
+                NSMutableArray *elements = parent.values[frame.propertyKey];
+                if (!elements) {
+                    elements = [NSMutableArray new];
+                    parent.values[frame.propertyKey] = elements;
+                }
+                [elements addObject:value];
+            } else if (member.isFlattened && member.shape.type == AWSShapeTypeMap) {
+                NSMutableDictionary *entries = parent.values[frame.propertyKey];
+                if (!entries) {
+                    entries = [NSMutableDictionary new];
+                    parent.values[frame.propertyKey] = entries;
+                }
+                if (frame.entryKey && frame.entryValue) {
+                    entries[frame.entryKey] = frame.entryValue;
+                }
+            } else {
+                parent.values[frame.propertyKey] = value;
+            }
+            break;
+        }
+        case AWSXMLDecoderFrameRoleListItem:
+            [parent.elements addObject:value];
+            break;
+        case AWSXMLDecoderFrameRoleMapEntry:
+            if (frame.entryKey && frame.entryValue) {
+                parent.values[frame.entryKey] = frame.entryValue;
+            }
+            break;
+        case AWSXMLDecoderFrameRoleMapKey:
+            parent.entryKey = value;
+            break;
+        case AWSXMLDecoderFrameRoleMapValue:
+            parent.entryValue = value;
+            break;
+        case AWSXMLDecoderFrameRoleGenericChild: {
+            // Repeated elements are collected in an array, as AWSXMLDictionaryParser does.
+            id existingValue = parent.values[frame.elementName];
+            if (!existingValue) {
+                parent.values[frame.elementName] = value;
+            } else if ([existingValue isKindOfClass:[NSMutableArray class]]) {
+                [existingValue addObject:value];
+            } else {
+                parent.values[frame.elementName] = [NSMutableArray arrayWithObjects:existingValue, value, nil];
+            }
+            break;
+        }
+    }
+    return YES;
+}
+
+- (id)modelForFrame:(AWSXMLDecoderFrame *)frame {
+    // Models nested at any depth were built already, so only the transformers of other values are applied, as
+    // AWSMTLJSONAdapter would. Flattened lists and maps are only complete once the structure ends.
+    for (AWSShapeMember *member in frame.shape.members) {
+        NSString *propertyKey = frame.metadata.propertyKeysByJSONKey[member.name];
+        id value = propertyKey ? frame.values[propertyKey] : nil;
+        NSValueTransformer *transformer = value ? frame.metadata.transformersByPropertyKey[propertyKey] : nil;
+        if (transformer
+            && member.shape.type != AWSShapeTypeStructure
+            && ![self.mapping shapeHoldsModels:member.shape]) {
+            frame.values[propertyKey] = [transformer transformedValue:value] ?: [NSNull null];
+        }
+    }
+
+    NSError *error = nil;
+    id model = [frame.metadata.modelClass modelWithDictionary:frame.values error:&error];
+    if (!model) {
+        if (error) {
+            self.error = error;
+        } else {
+            [self failWithCode:AWSXMLParserUnknownError
+                   description:[NSString stringWithFormat:@"%@ could not be created from the response", frame.metadata.modelClass]];
+        }
+    }
+    return model;
+}
+
+// Converts the text of an element as +[AWSXMLParser parseMember:rules:error:] does.
+- (id)scalarWithText:(NSString *)text member:(AWSShapeMember *)member {
+    switch (member.shape.type) {
+        case AWSShapeTypeInteger:
+        case AWSShapeTypeLong:
+            return [NSNumber numberWithInteger:[text integerValue]];
+        case AWSShapeTypeFloat:
+        case AWSShapeTypeDouble:
+            return [NSNumber numberWithDouble:[text doubleValue]];
+        case AWSShapeTypeBoolean:
+            return [NSNumber numberWithBool:[text boolValue]];
+        case AWSShapeTypeTimestamp: {
+            NSDate *timeStampDate = [NSDate aws_dateFromString:text] ?: [NSDate dateWithTimeIntervalSince1970:[text doubleValue]];
+            if ([member.timestampFormat isEqualToString:@"unixTimestamp"]) {
+                return [NSString stringWithFormat:@"%.lf", [timeStampDate timeIntervalSince1970]];
+            }
+            return [timeStampDate aws_stringValue:AWSDateISO8601DateFormat1];
+        }
+        case AWSShapeTypeBlob:
+            return [[NSData alloc] initWithBase64EncodedString:text options:0] ?: text;
+        default:
+            return text;
+    }
+}
+
+- (id)decodedModelWithError:(NSError *__autoreleasing *)error {
+    if (!self.error && (self.state == AWSXMLDecoderStateMarkup || [self.frames count] > 0 || self.skipDepth > 0)) {
+        [self failWithSyntaxError:NSXMLParserPrematureDocumentEndError];
+    }
+
+    if (!self.error && !self.rootValue) {
+        // An empty body makes an empty model, as with AWSXMLParser.
+        NSError *modelError = nil;
+        self.rootValue = [self.modelClass modelWithDictionary:@{} error:&modelError];
+        self.error = modelError;
+    }
+
+    if (self.error) {
+        if (error) {
+            *error = self.error;
+        }
+        return nil;
+    }
+    return self.rootValue;
+}
+
+@end
@@ -19,6 +19,7 @@
 #import "AWSServiceEnum.h"
 
 @class AWSEndpoint;
+@class AWSExecutor;
 
 #pragma mark - AWSService
 
@@ -67,6 +68,11 @@
 @property (nonatomic, strong, readonly) id<AWSCredentialsProvider> credentialsProvider;
 @property (nonatomic, strong, readonly) AWSEndpoint *endpoint;
 
+/**
+ The executor running the background work of high level clients, such as record submission in `AWSKinesisRecorder` and event delivery in `AWSMobileAnalytics`. The default is nil meaning `[AWSExecutor defaultExecutor]`. Set it to `[AWSExecutor backgroundExecutor]` to throttle that work.
+ */
+@property (nonatomic, strong) AWSExecutor *executor;
+
 - (instancetype)initWithRegion:(AWSRegionType)regionType
            credentialsProvider:(id<AWSCredentialsProvider>)credentialsProvider;
 
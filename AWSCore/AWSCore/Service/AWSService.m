@@ -115,6 +115,7 @@
     configuration.maxRetryCount = self.maxRetryCount;
     configuration.timeoutIntervalForRequest = self.timeoutIntervalForRequest;
     configuration.timeoutIntervalForResource = self.timeoutIntervalForResource;
+    configuration.executor = self.executor;
 
     return configuration;
 }
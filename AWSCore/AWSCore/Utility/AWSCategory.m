@@ -21,6 +21,7 @@
 #import "AWSLogging.h"
 #import "AWSGZIP.h"
 #import "AWSMantle.h"
+#import "AWSClassMetadata.h"
 
 NSString *const AWSiOSSDKVersion = @"2.2.6";
 
@@ -30,6 +31,8 @@ NSString *const AWSDateISO8601DateFormat2 = @"yyyyMMdd'T'HHmmss'Z'";
 NSString *const AWSDateISO8601DateFormat3 = @"yyyy-MM-dd'T'HH:mm:ss.SSS'Z'";
 NSString *const AWSDateShortDateFormat1 = @"yyyyMMdd";
 
+static NSString *const AWSDateFormattersThreadDictionaryKey = @"com.amazonaws.AWSCategory.dateFormatters";
+
 @interface AWSCategory : NSObject
 
 + (void)loadCategories;
@@ -49,6 +52,225 @@ NSString *const AWSDateShortDateFormat1 = @"yyyyMMdd";
 
 @end
 
+#pragma mark - Fixed width dates
+
+// The AWS date formats are fixed width and always in GMT, so they are formatted and parsed by hand instead of with an NSDateFormatter.
+typedef NS_ENUM(NSInteger, AWSDateFixedFormat) {
+    AWSDateFixedFormatNone,
+    AWSDateFixedFormatRFC822,
+    AWSDateFixedFormatISO8601,
+    AWSDateFixedFormatISO8601Basic,
+    AWSDateFixedFormatISO8601Milliseconds,
+    AWSDateFixedFormatShortDate,
+};
+
+static const char *const AWSDateWeekdayNames[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+static const char *const AWSDateMonthNames[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
+static AWSDateFixedFormat AWSDateFixedFormatFromDateFormat(NSString *dateFormat) {
+    if (dateFormat == AWSDateISO8601DateFormat2 || [dateFormat isEqualToString:AWSDateISO8601DateFormat2]) {
+        return AWSDateFixedFormatISO8601Basic;
+    } else if (dateFormat == AWSDateShortDateFormat1 || [dateFormat isEqualToString:AWSDateShortDateFormat1]) {
+        return AWSDateFixedFormatShortDate;
+    } else if (dateFormat == AWSDateRFC822DateFormat1 || [dateFormat isEqualToString:AWSDateRFC822DateFormat1]) {
+        return AWSDateFixedFormatRFC822;
+    } else if (dateFormat == AWSDateISO8601DateFormat1 || [dateFormat isEqualToString:AWSDateISO8601DateFormat1]) {
+        return AWSDateFixedFormatISO8601;
+    } else if (dateFormat == AWSDateISO8601DateFormat3 || [dateFormat isEqualToString:AWSDateISO8601DateFormat3]) {
+        return AWSDateFixedFormatISO8601Milliseconds;
+    }
+    return AWSDateFixedFormatNone;
+}
+
+static NSString *AWSDateFixedFormatString(NSDate *date, AWSDateFixedFormat format) {
+    NSTimeInterval timeInterval = [date timeIntervalSince1970];
+    NSTimeInterval seconds = floor(timeInterval);
+    time_t time = (time_t)seconds;
+    struct tm components;
+    if (!gmtime_r(&time, &components)
+        || components.tm_year + 1900 < 0
+        || components.tm_year + 1900 > 9999) {
+        return nil;
+    }
+
+    int year = components.tm_year + 1900;
+    int month = components.tm_mon + 1;
+    char buffer[32];
+    int length = 0;
+    switch (format) {
+        case AWSDateFixedFormatRFC822:
+            length = snprintf(buffer, sizeof(buffer), "%s, %02d %s %04d %02d:%02d:%02d GMT",
+                              AWSDateWeekdayNames[components.tm_wday], components.tm_mday, AWSDateMonthNames[components.tm_mon], year,
+                              components.tm_hour, components.tm_min, components.tm_sec);
+            break;
+        case AWSDateFixedFormatISO8601:
+            length = snprintf(buffer, sizeof(buffer), "%04d-%02d-%02dT%02d:%02d:%02dZ",
+                              year, month, components.tm_mday,
+                              components.tm_hour, components.tm_min, components.tm_sec);
+            break;
+        case AWSDateFixedFormatISO8601Basic:
+            length = snprintf(buffer, sizeof(buffer), "%04d%02d%02dT%02d%02d%02dZ",
+                              year, month, components.tm_mday,
+                              components.tm_hour, components.tm_min, components.tm_sec);
+            break;
+        case AWSDateFixedFormatISO8601Milliseconds:
+            length = snprintf(buffer, sizeof(buffer), "%04d-%02d-%02dT%02d:%02d:%02d.%03dZ",
+                              year, month, components.tm_mday,
+                              components.tm_hour, components.tm_min, components.tm_sec,
+                              MIN((int)((timeInterval - seconds) * 1000), 999));
+            break;
+        case AWSDateFixedFormatShortDate:
+            length = snprintf(buffer, sizeof(buffer), "%04d%02d%02d", year, month, components.tm_mday);
+            break;
+        default:
+            return nil;
+    }
+
+    return [[NSString alloc] initWithBytes:buffer length:length encoding:NSASCIIStringEncoding];
+}
+
+static BOOL AWSDateParseDigits(const char *characters, int count, int *value) {
+    int result = 0;
+    for (int i = 0; i < count; i++) {
+        if (characters[i] < '0' || characters[i] > '9') {
+            return NO;
+        }
+        result = result * 10 + (characters[i] - '0');
+    }
+    *value = result;
+    return YES;
+}
+
+static int AWSDateParseName(const char *characters, const char *const names[], int count) {
+    for (int i = 0; i < count; i++) {
+        if (strncmp(characters, names[i], 3) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Returns nil when the string is not exactly in the format, and the caller falls back to NSDateFormatter.
+static NSDate *AWSDateFromFixedFormatString(NSString *string, AWSDateFixedFormat format) {
+    char characters[32];
+    if ([string length] >= sizeof(characters)
+        || ![string getCString:characters maxLength:sizeof(characters) encoding:NSASCIIStringEncoding]) {
+        return nil;
+    }
+    size_t length = strlen(characters);
+
+    int year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0, millisecond = 0, weekday = -1;
+    BOOL parsed = NO;
+    switch (format) {
+        case AWSDateFixedFormatRFC822:
+            // Wed, 15 Oct 2014 22:18:01 GMT
+            parsed = (length == 29
+                      && (weekday = AWSDateParseName(characters, AWSDateWeekdayNames, 7)) >= 0
+                      && strncmp(characters + 3, ", ", 2) == 0
+                      && AWSDateParseDigits(characters + 5, 2, &day)
+                      && characters[7] == ' '
+                      && (month = AWSDateParseName(characters + 8, AWSDateMonthNames, 12) + 1) > 0
+                      && characters[11] == ' '
+                      && AWSDateParseDigits(characters + 12, 4, &year)
+                      && characters[16] == ' '
+                      && AWSDateParseDigits(characters + 17, 2, &hour)
+                      && characters[19] == ':'
+                      && AWSDateParseDigits(characters + 20, 2, &minute)
+                      && characters[22] == ':'
+                      && AWSDateParseDigits(characters + 23, 2, &second)
+                      && strcmp(characters + 25, " GMT") == 0);
+            break;
+        case AWSDateFixedFormatISO8601:
+        case AWSDateFixedFormatISO8601Milliseconds:
+            // 2014-10-15T22:18:01Z or 2014-10-15T22:18:01.123Z
+            parsed = (length == (format == AWSDateFixedFormatISO8601 ? 20 : 24)
+                      && AWSDateParseDigits(characters, 4, &year)
+                      && characters[4] == '-'
+                      && AWSDateParseDigits(characters + 5, 2, &month)
+                      && characters[7] == '-'
+                      && AWSDateParseDigits(characters + 8, 2, &day)
+                      && characters[10] == 'T'
+                      && AWSDateParseDigits(characters + 11, 2, &hour)
+                      && characters[13] == ':'
+                      && AWSDateParseDigits(characters + 14, 2, &minute)
+                      && characters[16] == ':'
+                      && AWSDateParseDigits(characters + 17, 2, &second)
+                      && (format == AWSDateFixedFormatISO8601
+                          || (characters[19] == '.' && AWSDateParseDigits(characters + 20, 3, &millisecond)))
+                      && characters[length - 1] == 'Z');
+            break;
+        case AWSDateFixedFormatISO8601Basic:
+            // 20141015T221801Z
+            parsed = (length == 16
+                      && AWSDateParseDigits(characters, 4, &year)
+                      && AWSDateParseDigits(characters + 4, 2, &month)
+                      && AWSDateParseDigits(characters + 6, 2, &day)
+                      && characters[8] == 'T'
+                      && AWSDateParseDigits(characters + 9, 2, &hour)
+                      && AWSDateParseDigits(characters + 11, 2, &minute)
+                      && AWSDateParseDigits(characters + 13, 2, &second)
+                      && characters[15] == 'Z');
+            break;
+        case AWSDateFixedFormatShortDate:
+            // 20141015
+            parsed = (length == 8
+                      && AWSDateParseDigits(characters, 4, &year)
+                      && AWSDateParseDigits(characters + 4, 2, &month)
+                      && AWSDateParseDigits(characters + 6, 2, &day));
+            break;
+        default:
+            break;
+    }
+    if (!parsed) {
+        return nil;
+    }
+
+    struct tm components = {0};
+    components.tm_year = year - 1900;
+    components.tm_mon = month - 1;
+    components.tm_mday = day;
+    components.tm_hour = hour;
+    components.tm_min = minute;
+    components.tm_sec = second;
+    time_t time = timegm(&components);
+
+    // timegm normalizes out of range fields (e.g. February 30th); leave those, and mismatched weekdays, to NSDateFormatter.
+    struct tm normalizedComponents;
+    if (!gmtime_r(&time, &normalizedComponents)
+        || normalizedComponents.tm_year != year - 1900
+        || normalizedComponents.tm_mon != month - 1
+        || normalizedComponents.tm_mday != day
+        || normalizedComponents.tm_hour != hour
+        || normalizedComponents.tm_min != minute
+        || normalizedComponents.tm_sec != second
+        || (weekday >= 0 && normalizedComponents.tm_wday != weekday)) {
+        return nil;
+    }
+
+    return [NSDate dateWithTimeIntervalSince1970:time + millisecond / 1000.0];
+}
+
+// NSDateFormatter is expensive to create and not safe to share while it is configured, so every thread keeps its own per format.
+static NSDateFormatter *AWSDateFormatterForCurrentThread(NSString *dateFormat) {
+    NSMutableDictionary *threadDictionary = [[NSThread currentThread] threadDictionary];
+    NSMutableDictionary *dateFormatters = threadDictionary[AWSDateFormattersThreadDictionaryKey];
+    if (!dateFormatters) {
+        dateFormatters = [NSMutableDictionary new];
+        threadDictionary[AWSDateFormattersThreadDictionaryKey] = dateFormatters;
+    }
+
+    NSDateFormatter *dateFormatter = dateFormatters[dateFormat];
+    if (!dateFormatter) {
+        dateFormatter = [NSDateFormatter new];
+        dateFormatter.timeZone = [NSTimeZone timeZoneWithName:@"GMT"];
+        dateFormatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
+        dateFormatter.dateFormat = dateFormat;
+        dateFormatters[dateFormat] = dateFormatter;
+    }
+
+    return dateFormatter;
+}
+
 @implementation NSDate (AWS)
 
 static NSTimeInterval _clockskew = 0.0;
@@ -73,21 +295,34 @@ static NSTimeInterval _clockskew = 0.0;
 }
 
 + (NSDate *)aws_dateFromString:(NSString *)string format:(NSString *)dateFormat {
-    NSDateFormatter *dateFormatter = [NSDateFormatter new];
-    dateFormatter.timeZone = [NSTimeZone timeZoneWithName:@"GMT"];
-    dateFormatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
-    dateFormatter.dateFormat = dateFormat;
+    if (!string) {
+        return nil;
+    }
+    dateFormat = dateFormat ?: @"";
+
+    AWSDateFixedFormat fixedFormat = AWSDateFixedFormatFromDateFormat(dateFormat);
+    if (fixedFormat != AWSDateFixedFormatNone) {
+        NSDate *date = AWSDateFromFixedFormatString(string, fixedFormat);
+        if (date) {
+            return date;
+        }
+    }
 
-    return [dateFormatter dateFromString:string];
+    return [AWSDateFormatterForCurrentThread(dateFormat) dateFromString:string];
 }
 
 - (NSString *)aws_stringValue:(NSString *)dateFormat {
-    NSDateFormatter *dateFormatter = [NSDateFormatter new];
-    dateFormatter.timeZone = [NSTimeZone timeZoneWithName:@"GMT"];
-    dateFormatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
-    dateFormatter.dateFormat = dateFormat;
+    dateFormat = dateFormat ?: @"";
 
-    return [dateFormatter stringFromDate:self];
+    AWSDateFixedFormat fixedFormat = AWSDateFixedFormatFromDateFormat(dateFormat);
+    if (fixedFormat != AWSDateFixedFormatNone) {
+        NSString *string = AWSDateFixedFormatString(self, fixedFormat);
+        if (string) {
+            return string;
+        }
+    }
+
+    return [AWSDateFormatterForCurrentThread(dateFormat) stringFromDate:self];
 }
 
 + (void)aws_setRuntimeClockSkew:(NSTimeInterval)clockskew {
@@ -182,47 +417,25 @@ static NSTimeInterval _clockskew = 0.0;
 @implementation NSObject (AWS)
 
 - (NSDictionary *)aws_properties {
-    NSMutableDictionary *propertyDictionary;
-    if ([self superclass] != [NSObject class]) {
-    	propertyDictionary = [NSMutableDictionary dictionaryWithDictionary:[[self superclass] aws_properties]];
-    } else {
-    	propertyDictionary = [NSMutableDictionary dictionary];
-    }
-
-    unsigned int propertyListCount;
-    objc_property_t *properties = class_copyPropertyList([self class], &propertyListCount);
-    for(uint32_t i = 0; i < propertyListCount; i++) {
-        objc_property_t property = properties[i];
-        const char *propertyName = property_getName(property);
-        const char *attributes = property_getAttributes(property);
-        if(propertyName) {
-            NSString *propertyNameString = [NSString stringWithCString:propertyName
-                                                              encoding:[NSString defaultCStringEncoding]];
-            NSString *attributesString = [NSString stringWithCString:attributes
-                                                            encoding:[NSString defaultCStringEncoding]];
-            [propertyDictionary setObject:attributesString forKey:propertyNameString];
-        }
-    }
-    free(properties);
-
-    return propertyDictionary;
+    return [AWSClassMetadata metadataForClass:[self class]].attributesByPropertyName;
 }
 
 - (void)aws_copyPropertiesFromObject:(NSObject *)object {
-    NSDictionary *propertiesToObject = [self aws_properties];
-    NSDictionary *propertiesFromObject = [object aws_properties];
-    for (NSString *key in [propertiesFromObject allKeys]) {
-        if ([propertiesToObject objectForKey:key]) {
-            NSString *attributes = [propertiesFromObject valueForKey:key];
+    AWSClassMetadata *metadataToObject = [AWSClassMetadata metadataForClass:object_getClass(self)];
+    AWSClassMetadata *metadataFromObject = [AWSClassMetadata metadataForClass:object_getClass(object)];
+    for (AWSPropertyMetadata *propertyFromObject in metadataFromObject.properties) {
+        AWSPropertyMetadata *propertyToObject = metadataToObject.propertiesByName[propertyFromObject.name];
+        if (propertyToObject) {
             /**
              * If it's not a readonly property
              * Ref. https://developer.apple.com/library/ios/documentation/Cocoa/Conceptual/ObjCRuntimeGuide/Articles/ocrtPropertyIntrospection.html#//apple_ref/doc/uid/TP40008048-CH101-SW1
              */
-            if ([attributes rangeOfString:@",R,"].location == NSNotFound) {
+            if (!propertyFromObject.isReadonly) {
+                NSString *key = propertyFromObject.name;
                 if (![key isEqualToString:@"uploadProgress"] && ![key isEqualToString:@"downloadProgress"]) {
                     //do not copy progress block since they do not have getter method and they have already been copied via internalRequest. copy it again will result in overwrite the current value to nil.
-                    [self setValue:[object valueForKey:key]
-                            forKey:key];
+                    [propertyToObject setValue:[propertyFromObject valueForObject:object]
+                                     forObject:self];
                 }
             }
         }
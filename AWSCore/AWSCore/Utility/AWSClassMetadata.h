@@ -0,0 +1,98 @@
+/*
+ Copyright 2010-2015 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License").
+ You may not use this file except in compliance with the License.
+ A copy of the License is located at
+
+ http://aws.amazon.com/apache2.0
+
+ or in the "license" file accompanying this file. This file is distributed
+ on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ express or implied. See the License for the specific language governing
+ permissions and limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+#import <objc/runtime.h>
+
+/**
+ The reflection of a property, read once from the runtime. Accessors of object properties are called through their
+ implementations directly, and other properties go through key-value coding.
+ */
+@interface AWSPropertyMetadata : NSObject
+
+@property (nonatomic, strong, readonly) NSString *name;
+
+/**
+ The attributes of the property, as returned by `property_getAttributes()`.
+ */
+@property (nonatomic, strong, readonly) NSString *attributes;
+
+/**
+ The class that declares the property. A property redeclared by a subclass is described by the subclass declaration.
+ */
+@property (nonatomic, assign, readonly) Class declaringClass;
+
+/**
+ The class of an object property, or `nil` if the property is of type `id`, is not an object, or its class is unknown.
+ */
+@property (nonatomic, assign, readonly) Class objectClass;
+
+@property (nonatomic, assign, readonly, getter=isObject) BOOL object;
+@property (nonatomic, assign, readonly, getter=isReadonly) BOOL readonly;
+@property (nonatomic, assign, readonly, getter=isWeak) BOOL weak;
+
+/**
+ Whether the property has a backing instance variable.
+ */
+@property (nonatomic, assign, readonly) BOOL hasIvar;
+
+@property (nonatomic, assign, readonly) SEL getter;
+@property (nonatomic, assign, readonly) SEL setter;
+
+/**
+ Whether `-validateValue:forKey:error:` may change or reject values of the property, that is, whether the class
+ implements a `validate<Key>:error:` method or overrides `-validateValue:forKey:error:`.
+ */
+@property (nonatomic, assign, readonly) BOOL validatesValue;
+
+/**
+ Returns the value of the property of an instance of the class, as `-valueForKey:` would.
+ */
+- (id)valueForObject:(id)object;
+
+/**
+ Sets the property of an instance of the class to a value, as `-setValue:forKey:` would.
+ */
+- (void)setValue:(id)value forObject:(id)object;
+
+@end
+
+/**
+ The properties of a class and its superclasses, below `NSObject`. The metadata of each class is built once and kept
+ for the life of the app.
+ */
+@interface AWSClassMetadata : NSObject
+
+@property (nonatomic, assign, readonly) Class metadataClass;
+
+/**
+ The `AWSPropertyMetadata` of every property, those declared by the class first.
+ */
+@property (nonatomic, strong, readonly) NSArray *properties;
+
+@property (nonatomic, strong, readonly) NSDictionary *propertiesByName;
+
+/**
+ The attributes of every property by property name, as returned by `-[NSObject aws_properties]`.
+ */
+@property (nonatomic, strong, readonly) NSDictionary *attributesByPropertyName;
+
+/**
+ Returns the cached metadata of a class. Pass `object_getClass()` of an instance rather than `-class`, so that the
+ accessors of classes created at runtime, such as those of key-value observing, are the ones called.
+ */
++ (instancetype)metadataForClass:(Class)metadataClass;
+
+@end
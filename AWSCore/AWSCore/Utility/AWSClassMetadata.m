@@ -0,0 +1,167 @@
+/*
+ Copyright 2010-2015 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License").
+ You may not use this file except in compliance with the License.
+ A copy of the License is located at
+
+ http://aws.amazon.com/apache2.0
+
+ or in the "license" file accompanying this file. This file is distributed
+ on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ express or implied. See the License for the specific language governing
+ permissions and limitations under the License.
+ */
+
+#import "AWSClassMetadata.h"
+
+#import "AWSEXTRuntimeExtensions.h"
+#import "AWSMTLReflection.h"
+
+@interface AWSPropertyMetadata()
+
+@property (nonatomic, strong) NSString *name;
+@property (nonatomic, strong) NSString *attributes;
+@property (nonatomic, assign) Class declaringClass;
+@property (nonatomic, assign) Class objectClass;
+@property (nonatomic, assign, getter=isObject) BOOL object;
+@property (nonatomic, assign, getter=isReadonly) BOOL readonly;
+@property (nonatomic, assign, getter=isWeak) BOOL weak;
+@property (nonatomic, assign) BOOL hasIvar;
+@property (nonatomic, assign) SEL getter;
+@property (nonatomic, assign) SEL setter;
+@property (nonatomic, assign) BOOL validatesValue;
+// The accessor implementations of the class the metadata is for, or NULL where key-value coding is used.
+@property (nonatomic, assign) IMP getterIMP;
+@property (nonatomic, assign) IMP setterIMP;
+
+@end
+
+@implementation AWSPropertyMetadata
+
+- (instancetype)initWithProperty:(objc_property_t)property
+                  declaringClass:(Class)declaringClass
+                        forClass:(Class)cls {
+    awsmtl_propertyAttributes *attributes = awsmtl_copyPropertyAttributes(property);
+    if (!attributes) {
+        return nil;
+    }
+
+    if (self = [super init]) {
+        _name = @(property_getName(property));
+        _attributes = @(property_getAttributes(property));
+        _declaringClass = declaringClass;
+        _objectClass = attributes->objectClass;
+        _object = attributes->type[0] == '@';
+        _readonly = attributes->readonly;
+        _weak = attributes->weak;
+        _hasIvar = attributes->ivar != NULL;
+        _getter = attributes->getter;
+        _setter = attributes->setter;
+
+        // The default validation accepts every value unchanged.
+        SEL validator = AWSMTLSelectorWithCapitalizedKeyPattern("validate", _name, ":error:");
+        _validatesValue = class_respondsToSelector(cls, validator)
+        || class_getMethodImplementation(cls, @selector(validateValue:forKey:error:)) != class_getMethodImplementation([NSObject class], @selector(validateValue:forKey:error:));
+
+        // Only accessors the class implements are called directly. Key-value coding finds the others, or falls back
+        // to the instance variable.
+        if (_object && class_getInstanceMethod(cls, _getter)) {
+            _getterIMP = class_getMethodImplementation(cls, _getter);
+        }
+        if (_object && !_readonly && class_getInstanceMethod(cls, _setter)) {
+            _setterIMP = class_getMethodImplementation(cls, _setter);
+        }
+    }
+    free(attributes);
+    return self;
+}
+
+- (id)valueForObject:(id)object {
+    if (self.getterIMP) {
+        return ((id (*)(id, SEL))self.getterIMP)(object, self.getter);
+    }
+    return [object valueForKey:self.name];
+}
+
+- (void)setValue:(id)value forObject:(id)object {
+    if (self.setterIMP) {
+        ((void (*)(id, SEL, id))self.setterIMP)(object, self.setter, value);
+        return;
+    }
+    [object setValue:value forKey:self.name];
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p; name = %@; attributes = %@>",
+            NSStringFromClass([self class]),
+            self,
+            self.name,
+            self.attributes];
+}
+
+@end
+
+@interface AWSClassMetadata()
+
+@property (nonatomic, assign) Class metadataClass;
+@property (nonatomic, strong) NSArray *properties;
+@property (nonatomic, strong) NSDictionary *propertiesByName;
+@property (nonatomic, strong) NSDictionary *attributesByPropertyName;
+
+@end
+
+@implementation AWSClassMetadata
+
++ (instancetype)metadataForClass:(Class)metadataClass {
+    static NSMutableDictionary *metadataByClass = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        metadataByClass = [NSMutableDictionary new];
+    });
+
+    @synchronized(metadataByClass) {
+        AWSClassMetadata *metadata = metadataByClass[(id<NSCopying>)metadataClass];
+        if (!metadata) {
+            metadata = [[AWSClassMetadata alloc] initWithClass:metadataClass];
+            metadataByClass[(id<NSCopying>)metadataClass] = metadata;
+        }
+        return metadata;
+    }
+}
+
+- (instancetype)initWithClass:(Class)metadataClass {
+    if (self = [super init]) {
+        _metadataClass = metadataClass;
+
+        NSMutableArray *properties = [NSMutableArray new];
+        NSMutableDictionary *propertiesByName = [NSMutableDictionary new];
+        NSMutableDictionary *attributesByPropertyName = [NSMutableDictionary new];
+        for (Class cls = metadataClass; cls && cls != [NSObject class]; cls = class_getSuperclass(cls)) {
+            unsigned int propertyListCount = 0;
+            objc_property_t *propertyList = class_copyPropertyList(cls, &propertyListCount);
+            for (unsigned int i = 0; i < propertyListCount; i++) {
+                NSString *name = @(property_getName(propertyList[i]));
+                // The declaration closest to the class wins.
+                if (propertiesByName[name]) {
+                    continue;
+                }
+                AWSPropertyMetadata *property = [[AWSPropertyMetadata alloc] initWithProperty:propertyList[i]
+                                                                              declaringClass:cls
+                                                                                    forClass:metadataClass];
+                if (property) {
+                    [properties addObject:property];
+                    propertiesByName[name] = property;
+                    attributesByPropertyName[name] = property.attributes;
+                }
+            }
+            free(propertyList);
+        }
+        _properties = properties;
+        _propertiesByName = propertiesByName;
+        _attributesByPropertyName = attributesByPropertyName;
+    }
+    return self;
+}
+
+@end
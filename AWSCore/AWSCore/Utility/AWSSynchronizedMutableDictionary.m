@@ -14,11 +14,16 @@
  */
 
 #import "AWSSynchronizedMutableDictionary.h"
+#import <pthread.h>
 
-@interface AWSSynchronizedMutableDictionary()
+// Keys are spread over several dictionaries, each with its own read-write lock, so that lookups run concurrently
+// and writers only contend with the operations on the same shard.
+#define AWSSynchronizedMutableDictionaryShardCount 16
 
-@property (nonatomic, strong) NSMutableDictionary *dictionary;
-@property (nonatomic, strong) dispatch_queue_t dispatchQueue;
+@interface AWSSynchronizedMutableDictionary() {
+    NSMutableDictionary *_shards[AWSSynchronizedMutableDictionaryShardCount];
+    pthread_rwlock_t _locks[AWSSynchronizedMutableDictionaryShardCount];
+}
 
 @end
 
@@ -26,40 +31,67 @@
 
 - (instancetype)init {
     if (self = [super init]) {
-        _dictionary = [NSMutableDictionary new];
-        _dispatchQueue = dispatch_queue_create("com.amazonaws.AWSSynchronizedMutableDictionary", DISPATCH_QUEUE_SERIAL);
+        for (NSUInteger i = 0; i < AWSSynchronizedMutableDictionaryShardCount; i++) {
+            _shards[i] = [NSMutableDictionary new];
+            pthread_rwlock_init(&_locks[i], NULL);
+        }
     }
 
     return self;
 }
 
+- (void)dealloc {
+    for (NSUInteger i = 0; i < AWSSynchronizedMutableDictionaryShardCount; i++) {
+        pthread_rwlock_destroy(&_locks[i]);
+    }
+}
+
+- (NSUInteger)shardForKey:(id)aKey {
+    NSUInteger hash = [aKey hash];
+    // NSNumber keys (e.g. task identifiers) hash to their value; fold the high bits in so that other hashes spread too.
+    hash ^= hash >> 16;
+    return hash % AWSSynchronizedMutableDictionaryShardCount;
+}
+
 - (id)objectForKey:(id)aKey {
-    __block id returnObject = nil;
+    NSUInteger shard = [self shardForKey:aKey];
 
-    dispatch_sync(self.dispatchQueue, ^{
-        returnObject = [self.dictionary objectForKey:aKey];
-    });
+    pthread_rwlock_rdlock(&_locks[shard]);
+    id returnObject = [_shards[shard] objectForKey:aKey];
+    pthread_rwlock_unlock(&_locks[shard]);
 
     return returnObject;
 }
 
 - (void)removeObjectForKey:(id)aKey {
-    dispatch_sync(self.dispatchQueue, ^{
-        [self.dictionary removeObjectForKey:aKey];
-    });
+    NSUInteger shard = [self shardForKey:aKey];
+    // the removed object is held until the end of the method, so that its dealloc never runs inside the lock.
+    NS_VALID_UNTIL_END_OF_SCOPE id removedObject = nil;
+
+    pthread_rwlock_wrlock(&_locks[shard]);
+    removedObject = [_shards[shard] objectForKey:aKey];
+    [_shards[shard] removeObjectForKey:aKey];
+    pthread_rwlock_unlock(&_locks[shard]);
 }
 
 - (void)setObject:(id)anObject forKey:(id <NSCopying>)aKey {
-    dispatch_sync(self.dispatchQueue, ^{
-        [self.dictionary setObject:anObject forKey:aKey];
-    });
+    NSUInteger shard = [self shardForKey:aKey];
+    NS_VALID_UNTIL_END_OF_SCOPE id replacedObject = nil;
+
+    pthread_rwlock_wrlock(&_locks[shard]);
+    replacedObject = [_shards[shard] objectForKey:aKey];
+    [_shards[shard] setObject:anObject forKey:aKey];
+    pthread_rwlock_unlock(&_locks[shard]);
 }
 
+// The shards are read one after another, so keys added or removed meanwhile may or may not be included.
 - (NSArray *)allKeys {
-    __block NSArray *allKeys = nil;
-    dispatch_sync(self.dispatchQueue, ^{
-        allKeys = [self.dictionary allKeys];
-    });
+    NSMutableArray *allKeys = [NSMutableArray new];
+    for (NSUInteger i = 0; i < AWSSynchronizedMutableDictionaryShardCount; i++) {
+        pthread_rwlock_rdlock(&_locks[i]);
+        [allKeys addObjectsFromArray:[_shards[i] allKeys]];
+        pthread_rwlock_unlock(&_locks[i]);
+    }
     return allKeys;
 }
 
@@ -238,17 +238,18 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
         }
         
         AWSNetworkingRequest *networkingRequest = request.internalRequest;
-        if (request) {
-            networkingRequest.parameters = [[AWSMTLJSONAdapter JSONDictionaryFromModel:request] aws_removeNullValues];
-        } else {
+        AWSJSONRequestSerializer *requestSerializer = [[AWSJSONRequestSerializer alloc] initWithJSONDefinition:[[AWSDynamoDBResources sharedInstance] JSONObject]
+                                                                                                    actionName:operationName];
+        if ([requestSerializer encodeBodyFromModel:request]) {
             networkingRequest.parameters = @{};
+        } else {
+            networkingRequest.parameters = [[AWSMTLJSONAdapter JSONDictionaryFromModel:request] aws_removeNullValues];
         }
         NSMutableDictionary *headers = [NSMutableDictionary new];
         headers[@"X-Amz-Target"] = [NSString stringWithFormat:@"%@.%@", targetPrefix, operationName];
         networkingRequest.headers = headers;
         networkingRequest.HTTPMethod = HTTPMethod;
-        networkingRequest.requestSerializer = [[AWSJSONRequestSerializer alloc] initWithJSONDefinition:[[AWSDynamoDBResources sharedInstance] JSONObject]
-                                                                                            actionName:operationName];
+        networkingRequest.requestSerializer = requestSerializer;
         networkingRequest.responseSerializer = [[AWSDynamoDBResponseSerializer alloc] initWithJSONDefinition:[[AWSDynamoDBResources sharedInstance] JSONObject]
                                                                                                   actionName:operationName
                                                                                                  outputClass:outputClass];
@@ -17,3 +17,4 @@
 #import <AWSCore/AWSCore.h>
 #import "AWSKinesisService.h"
 #import "AWSKinesisRecorder.h"
+#import "AWSKinesisAggregatedRecord.h"
@@ -0,0 +1,77 @@
+/*
+ Copyright 2010-2015 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License").
+ You may not use this file except in compliance with the License.
+ A copy of the License is located at
+
+ http://aws.amazon.com/apache2.0
+
+ or in the "license" file accompanying this file. This file is distributed
+ on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ express or implied. See the License for the specific language governing
+ permissions and limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+/**
+ The maximum size of the data of a Kinesis record.
+ */
+FOUNDATION_EXPORT NSUInteger const AWSKinesisAggregatedRecordMaximumSize;
+
+/**
+ Packs many user records into the data of one Kinesis record, in the aggregated record format of the Kinesis Producer Library (KPL). Consumers using the Kinesis Client Library de-aggregate these records transparently; consumers built on `- [AWSKinesis getRecords:]` can use `+ deaggregateRecords:`.
+ */
+@interface AWSKinesisAggregatedRecord : NSObject
+
+/**
+ The number of user records added so far.
+ */
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+/**
+ The size in bytes of `data` with the user records added so far.
+ */
+@property (nonatomic, assign, readonly) NSUInteger size;
+
+/**
+ The partition key of the first user record. Use it as the partition key of the Kinesis record. Kinesis routes the whole aggregated record to a single shard, so when the user records have different partition keys, set `explicitHashKey` of the Kinesis record to a hash key of the shard they all map to.
+ */
+@property (nonatomic, strong, readonly) NSString *partitionKey;
+
+/**
+ Returns the size `data` would have after adding the user record.
+
+ @param data         The data of the user record.
+ @param partitionKey The partition key of the user record.
+
+ @return The size in bytes.
+ */
+- (NSUInteger)sizeByAddingData:(NSData *)data
+                  partitionKey:(NSString *)partitionKey;
+
+/**
+ Adds a user record. Its partition key is kept in the partition key table of the aggregated record and restored by `+ deaggregateRecords:`.
+
+ @param data         The data of the user record.
+ @param partitionKey The partition key of the user record.
+ */
+- (void)addData:(NSData *)data
+   partitionKey:(NSString *)partitionKey;
+
+/**
+ Returns the aggregated record to send as the data of a Kinesis record.
+ */
+- (NSData *)data;
+
+/**
+ Expands aggregated records into their user records. Records that are not aggregated are returned as they are.
+
+ @param records An array of `AWSKinesisRecord` returned by `- [AWSKinesis getRecords:]`.
+
+ @return An array of `AWSKinesisRecord`. A user record has the sequence number of the Kinesis record that contained it.
+ */
++ (NSArray *)deaggregateRecords:(NSArray *)records;
+
+@end
@@ -0,0 +1,334 @@
+/*
+ Copyright 2010-2015 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License").
+ You may not use this file except in compliance with the License.
+ A copy of the License is located at
+
+ http://aws.amazon.com/apache2.0
+
+ or in the "license" file accompanying this file. This file is distributed
+ on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ express or implied. See the License for the specific language governing
+ permissions and limitations under the License.
+ */
+
+#import "AWSKinesisAggregatedRecord.h"
+#import <CommonCrypto/CommonDigest.h>
+#import "AWSKinesisModel.h"
+#import "AWSLogging.h"
+
+NSUInteger const AWSKinesisAggregatedRecordMaximumSize = 1024 * 1024; // 1MB
+
+/**
+ The aggregated record is the magic number, followed by an `AggregatedRecord` protobuf message and the MD5 of that message:
+
+     message AggregatedRecord {
+         repeated string partition_key_table = 1;
+         repeated string explicit_hash_key_table = 2;
+         repeated Record records = 3;
+     }
+     message Record {
+         required uint64 partition_key_index = 1;
+         optional uint64 explicit_hash_key_index = 2;
+         required bytes data = 3;
+         repeated Tag tags = 4;
+     }
+ */
+static const uint8_t AWSKinesisAggregatedRecordMagic[] = {0xF3, 0x89, 0x9A, 0xC2};
+
+typedef NS_ENUM(uint8_t, AWSKinesisProtobufWireType) {
+    AWSKinesisProtobufWireTypeVarint = 0,
+    AWSKinesisProtobufWireTypeFixed64 = 1,
+    AWSKinesisProtobufWireTypeLengthDelimited = 2,
+    AWSKinesisProtobufWireTypeFixed32 = 5,
+};
+
+// Field tags, i.e. (field number << 3) | wire type.
+static const uint8_t AWSKinesisAggregatedRecordPartitionKeyTableTag = (1 << 3) | AWSKinesisProtobufWireTypeLengthDelimited;
+static const uint8_t AWSKinesisAggregatedRecordRecordsTag = (3 << 3) | AWSKinesisProtobufWireTypeLengthDelimited;
+static const uint8_t AWSKinesisRecordPartitionKeyIndexTag = (1 << 3) | AWSKinesisProtobufWireTypeVarint;
+static const uint8_t AWSKinesisRecordDataTag = (3 << 3) | AWSKinesisProtobufWireTypeLengthDelimited;
+
+static NSUInteger AWSKinesisVarintSize(uint64_t value) {
+    NSUInteger size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        size++;
+    }
+    return size;
+}
+
+static void AWSKinesisAppendVarint(NSMutableData *data, uint64_t value) {
+    uint8_t buffer[10];
+    NSUInteger length = 0;
+    while (value >= 0x80) {
+        buffer[length++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    buffer[length++] = (uint8_t)value;
+    [data appendBytes:buffer length:length];
+}
+
+static BOOL AWSKinesisReadVarint(const uint8_t *bytes, NSUInteger length, NSUInteger *offset, uint64_t *value) {
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64 && *offset < length; shift += 7) {
+        uint8_t byte = bytes[(*offset)++];
+        result |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return YES;
+        }
+    }
+    return NO;
+}
+
+// Skips a field of the given wire type. Returns NO for a malformed message.
+static BOOL AWSKinesisSkipField(const uint8_t *bytes, NSUInteger length, NSUInteger *offset, uint8_t wireType) {
+    uint64_t value = 0;
+    switch (wireType) {
+        case AWSKinesisProtobufWireTypeVarint:
+            return AWSKinesisReadVarint(bytes, length, offset, &value);
+        case AWSKinesisProtobufWireTypeFixed64:
+            value = 8;
+            break;
+        case AWSKinesisProtobufWireTypeLengthDelimited:
+            if (!AWSKinesisReadVarint(bytes, length, offset, &value)) {
+                return NO;
+            }
+            break;
+        case AWSKinesisProtobufWireTypeFixed32:
+            value = 4;
+            break;
+        default:
+            return NO;
+    }
+    if (value > length - *offset) {
+        return NO;
+    }
+    *offset += (NSUInteger)value;
+    return YES;
+}
+
+static NSUInteger AWSKinesisPartitionKeyEntrySize(NSUInteger partitionKeyLength) {
+    return 1 + AWSKinesisVarintSize(partitionKeyLength) + partitionKeyLength;
+}
+
+static NSUInteger AWSKinesisRecordMessageSize(NSUInteger partitionKeyIndex, NSUInteger dataLength) {
+    return 1 + AWSKinesisVarintSize(partitionKeyIndex) + 1 + AWSKinesisVarintSize(dataLength) + dataLength;
+}
+
+static NSUInteger AWSKinesisRecordEntrySize(NSUInteger partitionKeyIndex, NSUInteger dataLength) {
+    NSUInteger messageSize = AWSKinesisRecordMessageSize(partitionKeyIndex, dataLength);
+    return 1 + AWSKinesisVarintSize(messageSize) + messageSize;
+}
+
+@interface AWSKinesisAggregatedRecord()
+
+@property (nonatomic, assign) NSUInteger count;
+@property (nonatomic, strong) NSString *partitionKey;
+
+// The size of the protobuf message.
+@property (nonatomic, assign) NSUInteger messageSize;
+@property (nonatomic, strong) NSMutableDictionary *partitionKeyIndexes;
+@property (nonatomic, strong) NSMutableArray *partitionKeyTable;
+@property (nonatomic, strong) NSMutableArray *userRecordData;
+@property (nonatomic, strong) NSMutableArray *userRecordPartitionKeyIndexes;
+
+@end
+
+@implementation AWSKinesisAggregatedRecord
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _partitionKeyIndexes = [NSMutableDictionary new];
+        _partitionKeyTable = [NSMutableArray new];
+        _userRecordData = [NSMutableArray new];
+        _userRecordPartitionKeyIndexes = [NSMutableArray new];
+    }
+    return self;
+}
+
+- (NSUInteger)size {
+    return sizeof(AWSKinesisAggregatedRecordMagic) + self.messageSize + CC_MD5_DIGEST_LENGTH;
+}
+
+- (NSUInteger)sizeByAddingData:(NSData *)data
+                  partitionKey:(NSString *)partitionKey {
+    NSUInteger size = self.size;
+    NSNumber *partitionKeyIndex = self.partitionKeyIndexes[partitionKey];
+    if (!partitionKeyIndex) {
+        partitionKeyIndex = @([self.partitionKeyTable count]);
+        size += AWSKinesisPartitionKeyEntrySize([partitionKey lengthOfBytesUsingEncoding:NSUTF8StringEncoding]);
+    }
+    return size + AWSKinesisRecordEntrySize([partitionKeyIndex unsignedIntegerValue], [data length]);
+}
+
+- (void)addData:(NSData *)data
+   partitionKey:(NSString *)partitionKey {
+    NSNumber *partitionKeyIndex = self.partitionKeyIndexes[partitionKey];
+    if (!partitionKeyIndex) {
+        partitionKeyIndex = @([self.partitionKeyTable count]);
+        self.partitionKeyIndexes[partitionKey] = partitionKeyIndex;
+        [self.partitionKeyTable addObject:partitionKey];
+        self.messageSize += AWSKinesisPartitionKeyEntrySize([partitionKey lengthOfBytesUsingEncoding:NSUTF8StringEncoding]);
+    }
+    if (!self.partitionKey) {
+        self.partitionKey = partitionKey;
+    }
+
+    [self.userRecordData addObject:data];
+    [self.userRecordPartitionKeyIndexes addObject:partitionKeyIndex];
+    self.messageSize += AWSKinesisRecordEntrySize([partitionKeyIndex unsignedIntegerValue], [data length]);
+    self.count++;
+}
+
+- (NSData *)data {
+    NSMutableData *data = [NSMutableData dataWithCapacity:self.size];
+    [data appendBytes:AWSKinesisAggregatedRecordMagic length:sizeof(AWSKinesisAggregatedRecordMagic)];
+
+    for (NSString *partitionKey in self.partitionKeyTable) {
+        NSUInteger length = [partitionKey lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+        [data appendBytes:&AWSKinesisAggregatedRecordPartitionKeyTableTag length:1];
+        AWSKinesisAppendVarint(data, length);
+        [data appendBytes:[partitionKey UTF8String] length:length];
+    }
+
+    for (NSUInteger i = 0; i < self.count; i++) {
+        NSData *userRecordData = self.userRecordData[i];
+        NSUInteger partitionKeyIndex = [self.userRecordPartitionKeyIndexes[i] unsignedIntegerValue];
+
+        [data appendBytes:&AWSKinesisAggregatedRecordRecordsTag length:1];
+        AWSKinesisAppendVarint(data, AWSKinesisRecordMessageSize(partitionKeyIndex, [userRecordData length]));
+        [data appendBytes:&AWSKinesisRecordPartitionKeyIndexTag length:1];
+        AWSKinesisAppendVarint(data, partitionKeyIndex);
+        [data appendBytes:&AWSKinesisRecordDataTag length:1];
+        AWSKinesisAppendVarint(data, [userRecordData length]);
+        [data appendData:userRecordData];
+    }
+
+    uint8_t digest[CC_MD5_DIGEST_LENGTH];
+    CC_MD5((const uint8_t *)[data bytes] + sizeof(AWSKinesisAggregatedRecordMagic),
+           (CC_LONG)([data length] - sizeof(AWSKinesisAggregatedRecordMagic)),
+           digest);
+    [data appendBytes:digest length:CC_MD5_DIGEST_LENGTH];
+
+    return data;
+}
+
++ (NSArray *)deaggregateRecords:(NSArray *)records {
+    NSMutableArray *userRecords = [NSMutableArray arrayWithCapacity:[records count]];
+    for (AWSKinesisRecord *record in records) {
+        NSArray *expandedRecords = [self userRecordsOfRecord:record];
+        if (expandedRecords) {
+            [userRecords addObjectsFromArray:expandedRecords];
+        } else {
+            [userRecords addObject:record];
+        }
+    }
+    return userRecords;
+}
+
+/**
+ Returns nil if the record is not an aggregated record.
+ */
++ (NSArray *)userRecordsOfRecord:(AWSKinesisRecord *)record {
+    NSData *data = record.data;
+    const uint8_t *bytes = [data bytes];
+    NSUInteger length = [data length];
+    if (length < sizeof(AWSKinesisAggregatedRecordMagic) + CC_MD5_DIGEST_LENGTH
+        || memcmp(bytes, AWSKinesisAggregatedRecordMagic, sizeof(AWSKinesisAggregatedRecordMagic)) != 0) {
+        return nil;
+    }
+
+    const uint8_t *message = bytes + sizeof(AWSKinesisAggregatedRecordMagic);
+    NSUInteger messageLength = length - sizeof(AWSKinesisAggregatedRecordMagic) - CC_MD5_DIGEST_LENGTH;
+    uint8_t digest[CC_MD5_DIGEST_LENGTH];
+    CC_MD5(message, (CC_LONG)messageLength, digest);
+    if (memcmp(digest, message + messageLength, CC_MD5_DIGEST_LENGTH) != 0) {
+        return nil;
+    }
+
+    NSMutableArray *partitionKeyTable = [NSMutableArray new];
+    NSMutableArray *userRecords = [NSMutableArray new];
+    NSMutableArray *userRecordPartitionKeyIndexes = [NSMutableArray new];
+    NSUInteger offset = 0;
+    while (offset < messageLength) {
+        uint64_t tag = 0;
+        if (!AWSKinesisReadVarint(message, messageLength, &offset, &tag)) {
+            return nil;
+        }
+
+        if (tag == AWSKinesisAggregatedRecordPartitionKeyTableTag
+            || tag == AWSKinesisAggregatedRecordRecordsTag) {
+            uint64_t fieldLength = 0;
+            if (!AWSKinesisReadVarint(message, messageLength, &offset, &fieldLength)
+                || fieldLength > messageLength - offset) {
+                return nil;
+            }
+
+            if (tag == AWSKinesisAggregatedRecordPartitionKeyTableTag) {
+                NSString *partitionKey = [[NSString alloc] initWithBytes:message + offset
+                                                                  length:(NSUInteger)fieldLength
+                                                                encoding:NSUTF8StringEncoding];
+                if (!partitionKey) {
+                    return nil;
+                }
+                [partitionKeyTable addObject:partitionKey];
+            } else {
+                // Parses a `Record` message.
+                NSUInteger recordOffset = offset;
+                NSUInteger recordEnd = offset + (NSUInteger)fieldLength;
+                uint64_t partitionKeyIndex = 0;
+                NSData *userRecordData = nil;
+                while (recordOffset < recordEnd) {
+                    uint64_t recordTag = 0;
+                    if (!AWSKinesisReadVarint(message, recordEnd, &recordOffset, &recordTag)) {
+                        return nil;
+                    }
+                    if (recordTag == AWSKinesisRecordPartitionKeyIndexTag) {
+                        if (!AWSKinesisReadVarint(message, recordEnd, &recordOffset, &partitionKeyIndex)) {
+                            return nil;
+                        }
+                    } else if (recordTag == AWSKinesisRecordDataTag) {
+                        uint64_t dataLength = 0;
+                        if (!AWSKinesisReadVarint(message, recordEnd, &recordOffset, &dataLength)
+                            || dataLength > recordEnd - recordOffset) {
+                            return nil;
+                        }
+                        userRecordData = [NSData dataWithBytes:message + recordOffset length:(NSUInteger)dataLength];
+                        recordOffset += (NSUInteger)dataLength;
+                    } else if (!AWSKinesisSkipField(message, recordEnd, &recordOffset, recordTag & 0x07)) {
+                        return nil;
+                    }
+                }
+                if (!userRecordData) {
+                    return nil;
+                }
+                [userRecords addObject:userRecordData];
+                [userRecordPartitionKeyIndexes addObject:@(partitionKeyIndex)];
+            }
+            offset += (NSUInteger)fieldLength;
+        } else if (!AWSKinesisSkipField(message, messageLength, &offset, tag & 0x07)) {
+            return nil;
+        }
+    }
+
+    NSMutableArray *expandedRecords = [NSMutableArray arrayWithCapacity:[userRecords count]];
+    for (NSUInteger i = 0; i < [userRecords count]; i++) {
+        NSUInteger partitionKeyIndex = [userRecordPartitionKeyIndexes[i] unsignedIntegerValue];
+        if (partitionKeyIndex >= [partitionKeyTable count]) {
+            AWSLogError(@"Invalid partition key index [%lu] in the aggregated record [%@].", (unsigned long)partitionKeyIndex, record.sequenceNumber);
+            return nil;
+        }
+
+        AWSKinesisRecord *userRecord = [AWSKinesisRecord new];
+        userRecord.data = userRecords[i];
+        userRecord.partitionKey = partitionKeyTable[partitionKeyIndex];
+        userRecord.sequenceNumber = record.sequenceNumber;
+        [expandedRecords addObject:userRecord];
+    }
+    return expandedRecords;
+}
+
+@end
@@ -23,10 +23,16 @@ FOUNDATION_EXPORT NSString *const AWSKinesisRecorderErrorDomain;
 typedef NS_ENUM(NSInteger, AWSKinesisRecorderErrorType) {
     AWSKinesisRecorderErrorUnknown,
     AWSKinesisRecorderErrorDataTooLarge,
+    AWSKinesisRecorderErrorInvalidPartitionKey,
 };
 
 /**
- When a `saveRecord:streamName:` operation causes the disk size to exceed `notificationByteThreshold`, it posts `AWSKinesisRecorderByteThresholdReachedNotification`.
+ Returns the partition key for a record saved with `saveRecord:streamName:`. The key must be 1 to 256 characters long.
+ */
+typedef NSString *(^AWSKinesisRecorderPartitionKeyBlock)(NSData *data, NSString *streamName);
+
+/**
+ When a `saveRecord:streamName:` operation causes the bytes used by the stored records to exceed `notificationByteThreshold`, it posts `AWSKinesisRecorderByteThresholdReachedNotification`.
  */
 FOUNDATION_EXPORT NSString *const AWSKinesisRecorderByteThresholdReachedNotification;
 
@@ -63,6 +69,44 @@ FOUNDATION_EXPORT NSString *const AWSKinesisRecorderByteThresholdReachedNotifica
  */
 @property (nonatomic, assign) NSTimeInterval diskAgeLimit;
 
+/**
+ The maximum time a record passed to `saveRecord:streamName:` is buffered in memory before it is written to disk. All records buffered within the interval are committed in a single transaction. The default is 0.25 seconds.
+ @discussion Records still buffered when the app is terminated are lost. `submitAllRecords` and `removeAllRecords` write the buffered records before they run.
+ */
+@property (nonatomic, assign) NSTimeInterval saveRecordFlushInterval;
+
+/**
+ The number of buffered bytes that causes the buffered records to be written immediately, without waiting for `saveRecordFlushInterval`. The default is 256KB.
+ */
+@property (nonatomic, assign) NSUInteger saveRecordFlushByteThreshold;
+
+/**
+ The maximum number of PutRecords requests `submitAllRecords` keeps in flight for each stream. Each request carries up to 500 records and 5MB. The default value is 1, which sends the requests for a stream one after another.
+ @discussion A higher value submits a large backlog faster, but consecutive requests of a stream are then in flight at the same time, so records with the same partition key may reach Kinesis out of the order they were saved.
+ */
+@property (nonatomic, assign) NSUInteger maxConcurrentSubmissionsPerStream;
+
+/**
+ The number of times a record rejected with `ProvisionedThroughputExceededException` or `InternalFailure` is submitted before it is discarded. The default is 0 meaning it retries indefinitely.
+ */
+@property (nonatomic, assign) NSUInteger recordRetryLimit;
+
+/**
+ Whether `submitAllRecords` packs the records bound for the same shard into one Kinesis record, up to the 1MB record limit. The default is NO.
+ @discussion The records are packed in the aggregated record format of the Kinesis Producer Library and are de-aggregated transparently by the Kinesis Client Library. Consumers built on `- [AWSKinesis getRecords:]` can expand them with `+ [AWSKinesisAggregatedRecord deaggregateRecords:]`.
+
+ Like the Kinesis Producer Library, the recorder groups the records by the shard their partition key maps to and sends each aggregated record with the starting hash key of that shard as its explicit hash key, so every record still goes to the shard of its own partition key. This needs the shard layout of the stream, which is looked up with `describeStream:`, so the credentials must allow `kinesis:DescribeStream` as well as `kinesis:PutRecords`.
+
+ Until the lookup succeeds, or when it is not allowed, only records with the same partition key are packed together. Records saved with the default `partitionKeyBlock` have a random partition key each, so they are then sent one per Kinesis record and aggregation has no effect.
+ */
+@property (nonatomic, assign) BOOL aggregatesRecords;
+
+/**
+ Picks the partition key of each record saved with `saveRecord:streamName:`. The default is nil meaning every record gets a randomly generated partition key.
+ @discussion Set it to `shardBalancedPartitionKeyBlock` to spread the records evenly across the shards without generating a UUID per record.
+ */
+@property (nonatomic, copy) AWSKinesisRecorderPartitionKeyBlock partitionKeyBlock;
+
 /**
  Returns a shared instance of this service client using `[AWSServiceManager defaultServiceManager].defaultServiceConfiguration`. When `defaultServiceConfiguration` is not set, this method returns nil.
 
@@ -218,6 +262,8 @@ FOUNDATION_EXPORT NSString *const AWSKinesisRecorderByteThresholdReachedNotifica
 /**
  Saves a record to local storage to be sent later. The record will be submitted to the streamName provided with a randomly generated partition key to ensure equal distribution across shards.
 
+ The record is buffered and written together with the other records saved within `saveRecordFlushInterval`. The returned task completes once the record has been written to disk.
+
  @param data       The data to send to Amazon Kinesis.
  @param streamName The stream name for Amazon Kinesis.
 
@@ -226,9 +272,33 @@ FOUNDATION_EXPORT NSString *const AWSKinesisRecorderByteThresholdReachedNotifica
 - (AWSTask *)saveRecord:(NSData *)data
              streamName:(NSString *)streamName;
 
+/**
+ Saves a record to local storage to be sent later with the given partition key. Records with the same partition key go to the same shard. Their order is kept only on a best-effort basis: Kinesis does not guarantee the order of the records within a PutRecords request, records rejected by Kinesis are retried in a later request, and `maxConcurrentSubmissionsPerStream` above 1 sends requests side by side.
+
+ @param data         The data to send to Amazon Kinesis.
+ @param streamName   The stream name for Amazon Kinesis.
+ @param partitionKey The partition key for Amazon Kinesis. It must be 1 to 256 characters long.
+
+ @return AWSTask - task.result is always nil.
+ */
+- (AWSTask *)saveRecord:(NSData *)data
+             streamName:(NSString *)streamName
+           partitionKey:(NSString *)partitionKey;
+
+/**
+ Returns a partition key block that cycles through one partition key per open shard of the stream, so that consecutive records land on different shards.
+
+ The shards are looked up with `describeStream:` the first time a stream is used and every 10 minutes after that. A failed lookup is retried after a minute. Until a lookup succeeds, the block returns cheap sequential keys.
+
+ @return A block to set to `partitionKeyBlock`.
+ */
+- (AWSKinesisRecorderPartitionKeyBlock)shardBalancedPartitionKeyBlock;
+
 /**
  Submits all locally saved requests to Amazon Kinesis. Requests that are successfully sent will be deleted from the device. Requests that fail due to the device being offline will stop the submission process and be kept. Requests that fail due to other reasons (such as the request being invalid) will be deleted.
 
+ Different streams are submitted concurrently, with up to `maxConcurrentSubmissionsPerStream` requests in flight per stream.
+
  @return AWSTask - task.result is always nil.
  */
 - (AWSTask *)submitAllRecords;
@@ -240,4 +310,18 @@ FOUNDATION_EXPORT NSString *const AWSKinesisRecorderByteThresholdReachedNotifica
  */
 - (AWSTask *)removeAllRecords;
 
+/**
+ Returns the number of unused pages in the database file. The recorder returns them to the file system a few at a time while it is idle.
+
+ @return AWSTask - task.result is an `NSNumber` containing the number of reclaimable pages.
+ */
+- (AWSTask *)reclaimablePageCount;
+
+/**
+ Returns all unused pages in the database file to the file system immediately and truncates the write-ahead log.
+
+ @return AWSTask - task.result is always nil.
+ */
+- (AWSTask *)reclaimDiskSpace;
+
 @end
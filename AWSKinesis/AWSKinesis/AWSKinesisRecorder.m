@@ -15,11 +15,13 @@
 
 #import "AWSKinesisRecorder.h"
 #import "AWSKinesis.h"
+#import "AWSKinesisAggregatedRecord.h"
 #import "AWSBolts.h"
 #import "AWSLogging.h"
 #import "AWSCategory.h"
 #import "AWSFMDB.h"
 #import "AWSSynchronizedMutableDictionary.h"
+#import <CommonCrypto/CommonDigest.h>
 
 NSString *const AWSKinesisRecorderErrorDomain = @"com.amazonaws.AWSKinesisRecorderErrorDomain";
 
@@ -28,18 +30,352 @@ NSString *const AWSKinesisRecorderByteThresholdReachedNotificationDiskBytesUsedK
 NSString *const AWSKinesisRecorderDatabasePathPrefix = @"com/amazonaws/AWSKinesisRecorder";
 NSUInteger const AWSKinesisRecorderByteLimitDefault = 5 * 1024 * 1024; // 5MB
 NSTimeInterval const AWSKinesisRecorderAgeLimitDefault = 0.0; // Keeps the data indefinitely unless it hits the size limit.
+NSTimeInterval const AWSKinesisRecorderSaveRecordFlushIntervalDefault = 0.25;
+NSUInteger const AWSKinesisRecorderSaveRecordFlushByteThresholdDefault = 256 * 1024; // 256KB
+// Approximate per-row cost of the timestamp, the retry count and the SQLite record header.
+NSUInteger const AWSKinesisRecorderRecordOverheadBytes = 32;
+// Storage maintenance waits until the database has not been written to for this long.
+NSTimeInterval const AWSKinesisRecorderStorageMaintenanceIdleInterval = 5.0;
+// The number of free pages returned to the file system per maintenance step.
+NSUInteger const AWSKinesisRecorderIncrementalVacuumPageCount = 128;
+// The size the WAL file is truncated back to after a checkpoint.
+NSUInteger const AWSKinesisRecorderJournalSizeLimit = 1024 * 1024; // 1MB
+NSUInteger const AWSKinesisRecorderMaxConcurrentSubmissionsPerStreamDefault = 1;
+NSUInteger const AWSKinesisRecorderRecordRetryLimitDefault = 0; // Retries throttled records indefinitely.
+int const AWSKinesisRecorderSchemaVersion = 1;
+NSUInteger const AWSKinesisRecorderPartitionKeyLengthLimit = 256;
+NSTimeInterval const AWSKinesisRecorderShardPartitionKeysTTL = 10 * 60;
+// A failed shard lookup is retried after this long.
+NSTimeInterval const AWSKinesisRecorderShardLookupRetryInterval = 60;
+// Bounds the search for a partition key per shard. Shards covering less than 1/100000 of the hash key space may be left without one.
+NSUInteger const AWSKinesisRecorderShardPartitionKeysSearchLimit = 100000;
+// The PutRecords limits per request.
+NSUInteger const AWSKinesisRecorderPutRecordsCountLimit = 500;
+NSUInteger const AWSKinesisRecorderPutRecordsByteLimit = 5 * 1024 * 1024; // 5MB
 
 // Legacy constants
 NSString *const AWSKinesisRecorderCacheName = @"com.amazonaws.AWSKinesisRecorderCacheName.Cache";
 
+/**
+ A page of records of one stream, sent in a single PutRecords request. With aggregation, an entry stands for the rows packed into its aggregated record.
+ */
+@interface AWSKinesisRecorderBatch : NSObject
+
+@property (nonatomic, strong) NSString *streamName;
+@property (nonatomic, strong) NSMutableArray *records;
+// The rows of each entry, in rowid order.
+@property (nonatomic, strong) NSMutableArray *rowIds;
+// The highest retry count among the rows of each entry.
+@property (nonatomic, strong) NSMutableArray *retryCounts;
+// The bytes the rows of each entry use in the record table.
+@property (nonatomic, strong) NSMutableArray *recordBytes;
+// The bytes each entry adds to the request payload.
+@property (nonatomic, strong) NSMutableArray *entryBytes;
+// The size of the request payload.
+@property (nonatomic, assign) NSUInteger byteCount;
+
+- (void)addEntry:(AWSKinesisPutRecordsRequestEntry *)requestEntry
+           rowId:(NSNumber *)rowId
+      retryCount:(int)retryCount
+     recordBytes:(unsigned long long)recordBytes
+      entryBytes:(NSUInteger)entryBytes;
+
+- (void)addRowId:(NSNumber *)rowId
+  toEntryAtIndex:(NSUInteger)index
+      retryCount:(int)retryCount
+     recordBytes:(unsigned long long)recordBytes
+      entryBytes:(NSUInteger)entryBytes;
+
+- (void)closeAggregatedRecord:(AWSKinesisAggregatedRecord *)aggregatedRecord
+               ofEntryAtIndex:(NSUInteger)index
+              explicitHashKey:(NSString *)explicitHashKey;
+
+@end
+
+@implementation AWSKinesisRecorderBatch
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _records = [NSMutableArray new];
+        _rowIds = [NSMutableArray new];
+        _retryCounts = [NSMutableArray new];
+        _recordBytes = [NSMutableArray new];
+        _entryBytes = [NSMutableArray new];
+    }
+    return self;
+}
+
+- (void)addEntry:(AWSKinesisPutRecordsRequestEntry *)requestEntry
+           rowId:(NSNumber *)rowId
+      retryCount:(int)retryCount
+     recordBytes:(unsigned long long)recordBytes
+      entryBytes:(NSUInteger)entryBytes {
+    [self.records addObject:requestEntry];
+    [self.rowIds addObject:[NSMutableArray arrayWithObject:rowId]];
+    [self.retryCounts addObject:@(retryCount)];
+    [self.recordBytes addObject:@(recordBytes)];
+    [self.entryBytes addObject:@(entryBytes)];
+    self.byteCount += entryBytes;
+}
+
+- (void)addRowId:(NSNumber *)rowId
+  toEntryAtIndex:(NSUInteger)index
+      retryCount:(int)retryCount
+     recordBytes:(unsigned long long)recordBytes
+      entryBytes:(NSUInteger)entryBytes {
+    [self.rowIds[index] addObject:rowId];
+    self.retryCounts[index] = @(MAX([self.retryCounts[index] intValue], retryCount));
+    self.recordBytes[index] = @([self.recordBytes[index] unsignedLongLongValue] + recordBytes);
+    [self setEntryBytes:entryBytes atIndex:index];
+}
+
+- (void)setEntryBytes:(NSUInteger)entryBytes atIndex:(NSUInteger)index {
+    self.byteCount = self.byteCount - [self.entryBytes[index] unsignedIntegerValue] + entryBytes;
+    self.entryBytes[index] = @(entryBytes);
+}
+
+/**
+ Replaces the data of the entry with the aggregated record. An aggregated record holding a single record is sent as a plain record, like the Kinesis Producer Library does.
+ */
+- (void)closeAggregatedRecord:(AWSKinesisAggregatedRecord *)aggregatedRecord
+               ofEntryAtIndex:(NSUInteger)index
+              explicitHashKey:(NSString *)explicitHashKey {
+    AWSKinesisPutRecordsRequestEntry *requestEntry = self.records[index];
+    if (aggregatedRecord.count >= 2) {
+        requestEntry.data = [aggregatedRecord data];
+        requestEntry.explicitHashKey = explicitHashKey;
+    }
+    [self setEntryBytes:[requestEntry.data length] + [requestEntry.partitionKey lengthOfBytesUsingEncoding:NSUTF8StringEncoding]
+                atIndex:index];
+}
+
+@end
+
+typedef NS_ENUM(NSInteger, AWSKinesisRecorderRowOutcome) {
+    AWSKinesisRecorderRowOutcomeKeep,
+    AWSKinesisRecorderRowOutcomeDelete,
+    AWSKinesisRecorderRowOutcomeRetry,
+};
+
+/**
+ The state shared by the pipelines of one `submitAllRecords` call.
+ */
+@interface AWSKinesisRecorderSubmission : NSObject
+
+// The last row handed out per stream name. Only accessed on the database queue.
+@property (nonatomic, strong) NSMutableDictionary *lastRowIds;
+@property (atomic, strong, readonly) NSError *error;
+
+- (void)stopWithError:(NSError *)error;
+
+@end
+
+@interface AWSKinesisRecorderSubmission()
+
+@property (atomic, strong) NSError *error;
+
+@end
+
+@implementation AWSKinesisRecorderSubmission
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _lastRowIds = [NSMutableDictionary new];
+    }
+    return self;
+}
+
+- (void)stopWithError:(NSError *)error {
+    @synchronized(self) {
+        // Keeps the first error.
+        if (!self.error) {
+            self.error = error;
+        }
+    }
+}
+
+@end
+
+/**
+ The open shards of one stream, as used by `shardBalancedPartitionKeyBlock` and by aggregation. Guarded by @synchronized on the object.
+ */
+@interface AWSKinesisRecorderShardPartitionKeys : NSObject
+
+// One partition key per open shard.
+@property (nonatomic, strong) NSArray *partitionKeys;
+// The hash key ranges of the open shards, as parsed by AWSKinesisRecorderHashKeyRangesForShards.
+@property (nonatomic, strong) NSData *hashKeyRanges;
+// The starting hash key of each open shard, in the order of `hashKeyRanges`.
+@property (nonatomic, strong) NSArray *startingHashKeys;
+// The time the last lookup finished, or 0 before the first one.
+@property (nonatomic, assign) CFAbsoluteTime lookupTime;
+@property (nonatomic, assign) BOOL lookupFailed;
+@property (nonatomic, assign) BOOL lookingUp;
+@property (nonatomic, assign) NSUInteger nextIndex;
+
+@end
+
+@implementation AWSKinesisRecorderShardPartitionKeys
+
+@end
+
 @interface AWSKinesisRecorder()
 
 @property (nonatomic, strong) AWSKinesis *kinesis;
+// Runs the flushes, submissions and storage maintenance.
+@property (nonatomic, strong) AWSExecutor *executor;
 @property (nonatomic, strong) AWSFMDatabaseQueue *databaseQueue;
 @property (nonatomic, strong) NSString *databasePath;
 
+// Records waiting for the next flush. Guarded by @synchronized(self).
+@property (nonatomic, strong) NSMutableArray *pendingRecords;
+@property (nonatomic, strong) NSMutableArray *pendingRecordCompletionSources;
+@property (nonatomic, assign) NSUInteger pendingRecordsByteCount;
+@property (nonatomic, assign) BOOL timedFlushScheduled;
+@property (nonatomic, assign) BOOL immediateFlushScheduled;
+
+// The bytes used by the rows in the record table. Only accessed on the database queue.
+@property (nonatomic, assign) unsigned long long recordBytesUsed;
+// The time of the last write to the database. Only accessed on the database queue.
+@property (nonatomic, assign) CFAbsoluteTime lastWriteTime;
+// Guarded by @synchronized(self).
+@property (nonatomic, assign) BOOL storageMaintenanceScheduled;
+// Stream name to AWSKinesisRecorderShardPartitionKeys. Guarded by @synchronized on the dictionary.
+@property (nonatomic, strong) NSMutableDictionary *shardPartitionKeys;
+
 @end
 
+static unsigned long long AWSKinesisRecorderRecordBytes(NSData *data, NSString *partitionKey, NSString *streamName) {
+    return [data length]
+    + [partitionKey lengthOfBytesUsingEncoding:NSUTF8StringEncoding]
+    + [streamName lengthOfBytesUsingEncoding:NSUTF8StringEncoding]
+    + AWSKinesisRecorderRecordOverheadBytes;
+}
+
+// Parses a decimal hash key of up to 128 bits into a big-endian byte array.
+static BOOL AWSKinesisRecorderParseHashKey(NSString *decimalString, uint8_t hashKey[CC_MD5_DIGEST_LENGTH]) {
+    memset(hashKey, 0, CC_MD5_DIGEST_LENGTH);
+    const char *digits = [decimalString UTF8String];
+    if (!digits || !*digits) {
+        return NO;
+    }
+    for (const char *digit = digits; *digit; digit++) {
+        if (*digit < '0' || *digit > '9') {
+            return NO;
+        }
+        unsigned int carry = *digit - '0';
+        for (int i = CC_MD5_DIGEST_LENGTH - 1; i >= 0; i--) {
+            carry += hashKey[i] * 10;
+            hashKey[i] = carry & 0xff;
+            carry >>= 8;
+        }
+        if (carry) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+static NSArray *AWSKinesisRecorderOpenShards(NSArray *shards) {
+    NSMutableArray *openShards = [NSMutableArray new];
+    for (AWSKinesisShard *shard in shards) {
+        if (!shard.sequenceNumberRange.endingSequenceNumber) {
+            [openShards addObject:shard];
+        }
+    }
+    return openShards;
+}
+
+/**
+ Parses the hash key ranges of the shards into pairs of 128-bit big-endian integers, the starting hash key followed by the ending one. Returns nil when there are no shards or a range is invalid.
+ */
+static NSData *AWSKinesisRecorderHashKeyRangesForShards(NSArray *shards) {
+    NSUInteger shardCount = [shards count];
+    if (shardCount == 0) {
+        return nil;
+    }
+
+    NSMutableData *hashKeyRanges = [NSMutableData dataWithLength:shardCount * 2 * CC_MD5_DIGEST_LENGTH];
+    uint8_t (*ranges)[2][CC_MD5_DIGEST_LENGTH] = [hashKeyRanges mutableBytes];
+    for (NSUInteger i = 0; i < shardCount; i++) {
+        AWSKinesisShard *shard = shards[i];
+        if (!AWSKinesisRecorderParseHashKey(shard.hashKeyRange.startingHashKey, ranges[i][0])
+            || !AWSKinesisRecorderParseHashKey(shard.hashKeyRange.endingHashKey, ranges[i][1])) {
+            AWSLogError(@"Invalid hash key range: [%@]", shard.hashKeyRange);
+            return nil;
+        }
+    }
+    return hashKeyRanges;
+}
+
+// Returns the index of the range containing the hash key, or NSNotFound.
+static NSUInteger AWSKinesisRecorderShardIndexForHashKey(const uint8_t hashKey[CC_MD5_DIGEST_LENGTH], NSData *hashKeyRanges) {
+    const uint8_t (*ranges)[2][CC_MD5_DIGEST_LENGTH] = [hashKeyRanges bytes];
+    NSUInteger shardCount = [hashKeyRanges length] / sizeof(*ranges);
+    for (NSUInteger i = 0; i < shardCount; i++) {
+        if (memcmp(hashKey, ranges[i][0], CC_MD5_DIGEST_LENGTH) >= 0
+            && memcmp(hashKey, ranges[i][1], CC_MD5_DIGEST_LENGTH) <= 0) {
+            return i;
+        }
+    }
+    return NSNotFound;
+}
+
+/**
+ Returns the index of the shard Kinesis maps the partition key to. Kinesis maps a partition key to the shard whose hash key range contains the MD5 of the key as a 128-bit big-endian integer.
+ */
+static NSUInteger AWSKinesisRecorderShardIndexForPartitionKey(NSString *partitionKey, NSData *hashKeyRanges) {
+    uint8_t digest[CC_MD5_DIGEST_LENGTH];
+    CC_MD5([partitionKey UTF8String], (CC_LONG)[partitionKey lengthOfBytesUsingEncoding:NSUTF8StringEncoding], digest);
+    return AWSKinesisRecorderShardIndexForHashKey(digest, hashKeyRanges);
+}
+
+/**
+ Finds one partition key per shard by hashing short numeric keys until every shard has one.
+ */
+static NSArray *AWSKinesisRecorderPartitionKeysForHashKeyRanges(NSData *hashKeyRanges) {
+    NSUInteger shardCount = [hashKeyRanges length] / (2 * CC_MD5_DIGEST_LENGTH);
+    NSMutableArray *partitionKeys = [NSMutableArray arrayWithCapacity:shardCount];
+    for (NSUInteger i = 0; i < shardCount; i++) {
+        [partitionKeys addObject:[NSNull null]];
+    }
+    NSUInteger foundCount = 0;
+    for (unsigned long candidate = 0; candidate < AWSKinesisRecorderShardPartitionKeysSearchLimit && foundCount < shardCount; candidate++) {
+        char partitionKey[24];
+        int length = snprintf(partitionKey, sizeof(partitionKey), "%lu", candidate);
+        uint8_t digest[CC_MD5_DIGEST_LENGTH];
+        CC_MD5(partitionKey, (CC_LONG)length, digest);
+
+        NSUInteger index = AWSKinesisRecorderShardIndexForHashKey(digest, hashKeyRanges);
+        if (index != NSNotFound && partitionKeys[index] == [NSNull null]) {
+            partitionKeys[index] = [NSString stringWithUTF8String:partitionKey];
+            foundCount++;
+        }
+    }
+
+    [partitionKeys removeObject:[NSNull null]];
+    return partitionKeys;
+}
+
+// Records packed per shard are routed by the starting hash key of the shard, since their partition keys differ. Records packed per partition key are routed by that key.
+static NSString *AWSKinesisRecorderExplicitHashKeyForAggregationKey(id aggregationKey, NSArray *startingHashKeys) {
+    if ([aggregationKey isKindOfClass:[NSNumber class]]) {
+        return startingHashKeys[[aggregationKey unsignedIntegerValue]];
+    }
+    return nil;
+}
+
+// The SQL counterpart of AWSKinesisRecorderRecordBytes.
+static NSString *AWSKinesisRecorderRecordBytesExpression(void) {
+    return [NSString stringWithFormat:@"(LENGTH(data) + LENGTH(CAST(partition_key AS BLOB)) + LENGTH(CAST(stream_name AS BLOB)) + %lu)",
+            (unsigned long)AWSKinesisRecorderRecordOverheadBytes];
+}
+
+// wal_checkpoint(TRUNCATE) needs SQLite 3.8.8, which is newer than the system library on iOS 8. RESTART works everywhere, and journal_size_limit then trims the WAL file when it is reused.
+static NSString *AWSKinesisRecorderCheckpointStatement(void) {
+    return sqlite3_libversion_number() >= 3008008 ? @"PRAGMA wal_checkpoint(TRUNCATE)" : @"PRAGMA wal_checkpoint(RESTART)";
+}
+
 @implementation AWSKinesisRecorder
 
 static AWSSynchronizedMutableDictionary *_serviceClients = nil;
@@ -105,11 +441,19 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wdeprecated-declarations"
         _kinesis = [[AWSKinesis alloc] initWithConfiguration:configuration];
+        _executor = configuration.executor ?: [AWSExecutor defaultExecutor];
 #pragma clang diagnostic pop
 
         _databasePath = [databaseDirectoryPath stringByAppendingPathComponent:identifier];
         _diskByteLimit = AWSKinesisRecorderByteLimitDefault;
         _diskAgeLimit = AWSKinesisRecorderAgeLimitDefault;
+        _saveRecordFlushInterval = AWSKinesisRecorderSaveRecordFlushIntervalDefault;
+        _saveRecordFlushByteThreshold = AWSKinesisRecorderSaveRecordFlushByteThresholdDefault;
+        _maxConcurrentSubmissionsPerStream = AWSKinesisRecorderMaxConcurrentSubmissionsPerStreamDefault;
+        _recordRetryLimit = AWSKinesisRecorderRecordRetryLimitDefault;
+        _pendingRecords = [NSMutableArray new];
+        _pendingRecordCompletionSources = [NSMutableArray new];
+        _shardPartitionKeys = [NSMutableDictionary new];
 
         // Creates a directory for storing databases if it doesn't exist.
         BOOL fileExistsAtPath = [[NSFileManager defaultManager] fileExistsAtPath:databaseDirectoryPath];
@@ -127,9 +471,27 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
         // Creates a database for the identifier if it doesn't exist.
         AWSLogDebug(@"Database path: [%@]", _databasePath);
         _databaseQueue = [AWSFMDatabaseQueue databaseQueueWithPath:_databasePath];
+        __block unsigned long long recordBytesUsed = 0;
         [_databaseQueue inDatabase:^(AWSFMDatabase *db) {
-            if (![db executeStatements:@"PRAGMA auto_vacuum = FULL"]) {
-                AWSLogError(@"Failed to enable 'aut_vacuum' to 'FULL'. %@", db.lastError);
+            // Free pages are returned in small steps by the storage maintenance instead of rewriting the file with VACUUM.
+            if (![db executeStatements:@"PRAGMA auto_vacuum = INCREMENTAL"]) {
+                AWSLogError(@"Failed to set 'auto_vacuum' to 'INCREMENTAL'. %@", db.lastError);
+            }
+
+            // WAL lets a commit append to the log instead of rewriting pages in place, and needs fewer fsyncs with 'synchronous = NORMAL'.
+            AWSFMResultSet *rs = [db executeQuery:@"PRAGMA journal_mode = WAL"];
+            if (!rs) {
+                AWSLogError(@"Failed to set 'journal_mode' to 'WAL'. %@", db.lastError);
+            } else {
+                if ([rs next] && ![[rs stringForColumnIndex:0] isEqualToString:@"wal"]) {
+                    AWSLogWarn(@"The database is not in the WAL mode. journal_mode: [%@]", [rs stringForColumnIndex:0]);
+                }
+                [rs close];
+            }
+            if (![db executeStatements:[NSString stringWithFormat:
+                                        @"PRAGMA synchronous = NORMAL;"
+                                        @"PRAGMA journal_size_limit = %lu;", (unsigned long)AWSKinesisRecorderJournalSizeLimit]]) {
+                AWSLogError(@"SQLite error. [%@]", db.lastError);
             }
 
             if (![db executeUpdate:
@@ -141,13 +503,71 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
                   @"retry_count INTEGER NOT NULL)"]) {
                 AWSLogError(@"SQLite error. [%@]", db.lastError);
             }
+
+            // 'auto_vacuum' can only be switched on for a database without tables by VACUUM, so a database created without it is converted once.
+            if ([db intForQuery:@"PRAGMA auto_vacuum"] != 2) {
+                AWSLogInfo(@"Converting the database to 'auto_vacuum = INCREMENTAL'.");
+                if (![db executeStatements:@"PRAGMA auto_vacuum = INCREMENTAL; VACUUM;"]) {
+                    AWSLogError(@"SQLite error. [%@]", db.lastError);
+                }
+            }
+
+            [self migrateSchemaOfDatabase:db];
+
+            // Counts the records left over from previous sessions once; the count is maintained incrementally afterwards.
+            rs = [db executeQuery:[NSString stringWithFormat:
+                                   @"SELECT COALESCE(SUM(%@), 0) AS bytes "
+                                   @"FROM record", AWSKinesisRecorderRecordBytesExpression()]];
+            if (!rs) {
+                AWSLogError(@"SQLite error. [%@]", db.lastError);
+            } else {
+                if ([rs next]) {
+                    recordBytesUsed = [rs unsignedLongLongIntForColumn:@"bytes"];
+                }
+                [rs close];
+            }
         }];
+        _recordBytesUsed = recordBytesUsed;
     }
     return self;
 }
 
+/**
+ Brings the schema up to `AWSKinesisRecorderSchemaVersion`. The version is kept in `PRAGMA user_version`; each step runs in its own transaction.
+ */
+- (void)migrateSchemaOfDatabase:(AWSFMDatabase *)db {
+    int schemaVersion = [db intForQuery:@"PRAGMA user_version"];
+    if (schemaVersion >= AWSKinesisRecorderSchemaVersion) {
+        return;
+    }
+
+    if (schemaVersion < 1) {
+        // Every SQLite index ends with the rowid, so the stream name index serves 'WHERE stream_name = ? AND rowid > ? ORDER BY rowid'.
+        [db beginTransaction];
+        if (![db executeStatements:
+              @"CREATE INDEX IF NOT EXISTS record_stream_name_index ON record (stream_name);"
+              @"CREATE INDEX IF NOT EXISTS record_timestamp_index ON record (timestamp);"
+              @"PRAGMA user_version = 1;"]) {
+            AWSLogError(@"Failed to migrate the schema to version 1. Rolling back... [%@]", db.lastError);
+            [db rollback];
+            return;
+        }
+        [db commit];
+    }
+}
+
 - (AWSTask *)saveRecord:(NSData *)data
              streamName:(NSString *)streamName {
+    AWSKinesisRecorderPartitionKeyBlock partitionKeyBlock = self.partitionKeyBlock;
+    NSString *partitionKey = partitionKeyBlock ? partitionKeyBlock(data, streamName) : [[NSUUID UUID] UUIDString];
+    return [self saveRecord:data
+                 streamName:streamName
+               partitionKey:partitionKey];
+}
+
+- (AWSTask *)saveRecord:(NSData *)data
+             streamName:(NSString *)streamName
+           partitionKey:(NSString *)partitionKey {
     // Returns error if the total size of data and partition key exceeds 50KB.
     // Partition key limit is 256 bytes.
     if ([data length] > 50 * 1024 - 256) {
@@ -155,245 +575,680 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
                                                           code:AWSKinesisRecorderErrorDataTooLarge
                                                       userInfo:nil]];
     }
+    if ([partitionKey length] == 0
+        || [partitionKey length] > AWSKinesisRecorderPartitionKeyLengthLimit) {
+        return [AWSTask taskWithError:[NSError errorWithDomain:AWSKinesisRecorderErrorDomain
+                                                          code:AWSKinesisRecorderErrorInvalidPartitionKey
+                                                      userInfo:@{NSLocalizedDescriptionKey : @"The partition key must be 1 to 256 characters long."}]];
+    }
 
-    AWSFMDatabaseQueue *databaseQueue = self.databaseQueue;
+    NSDictionary *record = @{
+                             @"partition_key" : partitionKey,
+                             @"stream_name" : streamName,
+                             @"data" : data,
+                             @"timestamp" : @([[NSDate date] timeIntervalSince1970]),
+                             @"retry_count" : @0
+                             };
+    AWSTaskCompletionSource *completionSource = [AWSTaskCompletionSource taskCompletionSource];
+
+    BOOL shouldFlushImmediately = NO;
+    BOOL shouldScheduleFlush = NO;
+    @synchronized(self) {
+        [self.pendingRecords addObject:record];
+        [self.pendingRecordCompletionSources addObject:completionSource];
+        self.pendingRecordsByteCount += AWSKinesisRecorderRecordBytes(data, partitionKey, streamName);
+
+        if (self.pendingRecordsByteCount >= self.saveRecordFlushByteThreshold) {
+            if (!self.immediateFlushScheduled) {
+                self.immediateFlushScheduled = YES;
+                shouldFlushImmediately = YES;
+            }
+        } else if (!self.timedFlushScheduled) {
+            self.timedFlushScheduled = YES;
+            shouldScheduleFlush = YES;
+        }
+    }
+
+    // The flush blocks retain the recorder so that buffered records are written even if the caller releases it.
+    if (shouldFlushImmediately) {
+        [self.executor execute:^{
+            [self flushPendingRecords];
+        }];
+    } else if (shouldScheduleFlush) {
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.saveRecordFlushInterval * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            [self.executor execute:^{
+                [self flushPendingRecords];
+            }];
+        });
+    }
+
+    return completionSource.task;
+}
+
+- (AWSKinesisRecorderPartitionKeyBlock)shardBalancedPartitionKeyBlock {
+    __weak AWSKinesisRecorder *kinesisRecorder = self;
+    return ^NSString *(NSData *data, NSString *streamName) {
+        return [kinesisRecorder shardBalancedPartitionKeyForStreamName:streamName];
+    };
+}
+
+- (NSString *)shardBalancedPartitionKeyForStreamName:(NSString *)streamName {
+    AWSKinesisRecorderShardPartitionKeys *shardPartitionKeys = [self shardPartitionKeysForStreamName:streamName];
+
+    @synchronized(shardPartitionKeys) {
+        NSUInteger index = shardPartitionKeys.nextIndex++;
+        NSUInteger partitionKeyCount = [shardPartitionKeys.partitionKeys count];
+        if (partitionKeyCount > 0) {
+            return shardPartitionKeys.partitionKeys[index % partitionKeyCount];
+        }
+        // Sequential keys hash uniformly over the key space, which is the best available until the shards are known.
+        return [NSString stringWithFormat:@"%lu", (unsigned long)index];
+    }
+}
+
+/**
+ Returns the shard layout of the stream as known so far, and starts a lookup when none has been made yet, the last one failed more than `AWSKinesisRecorderShardLookupRetryInterval` ago, or the last successful one is older than `AWSKinesisRecorderShardPartitionKeysTTL`. A failed lookup keeps the keys of the previous one.
+ */
+- (AWSKinesisRecorderShardPartitionKeys *)shardPartitionKeysForStreamName:(NSString *)streamName {
+    AWSKinesisRecorderShardPartitionKeys *shardPartitionKeys = nil;
+    @synchronized(self.shardPartitionKeys) {
+        shardPartitionKeys = self.shardPartitionKeys[streamName];
+        if (!shardPartitionKeys) {
+            shardPartitionKeys = [AWSKinesisRecorderShardPartitionKeys new];
+            self.shardPartitionKeys[streamName] = shardPartitionKeys;
+        }
+    }
+
+    BOOL shouldLookUp = NO;
+    @synchronized(shardPartitionKeys) {
+        NSTimeInterval lookupInterval = shardPartitionKeys.lookupFailed ? AWSKinesisRecorderShardLookupRetryInterval : AWSKinesisRecorderShardPartitionKeysTTL;
+        if (!shardPartitionKeys.lookingUp
+            && (shardPartitionKeys.lookupTime == 0
+                || CFAbsoluteTimeGetCurrent() - shardPartitionKeys.lookupTime > lookupInterval)) {
+            shardPartitionKeys.lookingUp = YES;
+            shouldLookUp = YES;
+        }
+    }
+
+    if (shouldLookUp) {
+        [[self describeShardsOfStreamName:streamName
+                    exclusiveStartShardId:nil
+                                   shards:[NSMutableArray new]] continueWithBlock:^id(AWSTask *task) {
+            if (task.error) {
+                AWSLogWarn(@"Failed to look up the shards of [%@]. [%@]", streamName, task.error);
+            }
+            NSArray *openShards = AWSKinesisRecorderOpenShards(task.result);
+            NSData *hashKeyRanges = AWSKinesisRecorderHashKeyRangesForShards(openShards);
+            NSArray *partitionKeys = hashKeyRanges ? AWSKinesisRecorderPartitionKeysForHashKeyRanges(hashKeyRanges) : nil;
+            @synchronized(shardPartitionKeys) {
+                shardPartitionKeys.lookingUp = NO;
+                shardPartitionKeys.lookupTime = CFAbsoluteTimeGetCurrent();
+                shardPartitionKeys.lookupFailed = [partitionKeys count] == 0;
+                if (!shardPartitionKeys.lookupFailed) {
+                    shardPartitionKeys.partitionKeys = partitionKeys;
+                    shardPartitionKeys.hashKeyRanges = hashKeyRanges;
+                    shardPartitionKeys.startingHashKeys = [openShards valueForKeyPath:@"hashKeyRange.startingHashKey"];
+                }
+            }
+            return nil;
+        }];
+    }
+
+    return shardPartitionKeys;
+}
+
+- (AWSTask *)describeShardsOfStreamName:(NSString *)streamName
+                  exclusiveStartShardId:(NSString *)exclusiveStartShardId
+                                 shards:(NSMutableArray *)shards {
+    AWSKinesisDescribeStreamInput *describeStreamInput = [AWSKinesisDescribeStreamInput new];
+    describeStreamInput.streamName = streamName;
+    describeStreamInput.exclusiveStartShardId = exclusiveStartShardId;
+
+    return [[self.kinesis describeStream:describeStreamInput] continueWithSuccessBlock:^id(AWSTask *task) {
+        AWSKinesisDescribeStreamOutput *describeStreamOutput = task.result;
+        NSArray *page = describeStreamOutput.streamDescription.shards;
+        [shards addObjectsFromArray:page];
+
+        if ([describeStreamOutput.streamDescription.hasMoreShards boolValue] && [page count] > 0) {
+            return [self describeShardsOfStreamName:streamName
+                              exclusiveStartShardId:[[page lastObject] shardId]
+                                             shards:shards];
+        }
+        return [AWSTask taskWithResult:shards];
+    }];
+}
+
+/**
+ Writes the buffered records in a single transaction, then applies the age and size limits once for the whole batch.
+ */
+- (void)flushPendingRecords {
     NSTimeInterval diskAgeLimit = self.diskAgeLimit;
-    NSString *databasePath = self.databasePath;
     NSUInteger notificationByteThreshold = self.notificationByteThreshold;
     NSUInteger diskByteLimit = self.diskByteLimit;
-    __weak AWSKinesisRecorder *kinesisRecorder = self;
 
-    return [[AWSTask taskWithResult:nil] continueWithSuccessBlock:^id(AWSTask *task) {
-        // Inserts a new record to the database.
-        __block NSError *error = nil;
-        [databaseQueue inDatabase:^(AWSFMDatabase *db) {
+    __block NSArray *records = nil;
+    __block NSArray *completionSources = nil;
+    __block NSError *error = nil;
+    __block unsigned long long recordBytesUsed = 0;
+    __block BOOL recordDeleted = NO;
+
+    [self.databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
+        // Takes the buffer on the database queue so that batches are committed in the order they were filled.
+        @synchronized(self) {
+            records = self.pendingRecords;
+            completionSources = self.pendingRecordCompletionSources;
+            self.pendingRecords = [NSMutableArray new];
+            self.pendingRecordCompletionSources = [NSMutableArray new];
+            self.pendingRecordsByteCount = 0;
+            self.timedFlushScheduled = NO;
+            self.immediateFlushScheduled = NO;
+        }
+        if ([records count] == 0) {
+            return;
+        }
+
+        recordBytesUsed = self.recordBytesUsed;
+        self.lastWriteTime = CFAbsoluteTimeGetCurrent();
+
+        // Inserts the new records to the database.
+        for (NSDictionary *record in records) {
             BOOL result = [db executeUpdate:
                            @"INSERT INTO record ("
                            @"partition_key, stream_name, data, timestamp, retry_count"
                            @") VALUES ("
                            @":partition_key, :stream_name, :data, :timestamp, :retry_count"
                            @")"
-                    withParameterDictionary:@{
-                                              @"partition_key" : [[NSUUID UUID] UUIDString],
-                                              @"stream_name" : streamName,
-                                              @"data" : data,
-                                              @"timestamp" : @([[NSDate date] timeIntervalSince1970]),
-                                              @"retry_count" : @0
-                                              }
-                           ];
-
-
+                    withParameterDictionary:record];
             if (!result) {
-                AWSLogError(@"SQLite error. [%@]", db.lastError);
+                AWSLogError(@"SQLite error. Rolling back... [%@]", db.lastError);
                 error = db.lastError;
+                *rollback = YES;
+                return;
             }
-        }];
+            recordBytesUsed += AWSKinesisRecorderRecordBytes(record[@"data"], record[@"partition_key"], record[@"stream_name"]);
+        }
+
+        if (diskAgeLimit > 0) {
+            // Deletes old records exceeding the threshold.
+            NSDictionary *parameters = @{@"timestamp" : @([[NSDate date] timeIntervalSince1970] - diskAgeLimit)};
+            AWSFMResultSet *rs = [db executeQuery:[NSString stringWithFormat:
+                                                   @"SELECT COALESCE(SUM(%@), 0) AS bytes "
+                                                   @"FROM record "
+                                                   @"WHERE timestamp < :timestamp", AWSKinesisRecorderRecordBytesExpression()]
+                          withParameterDictionary:parameters];
+            if (!rs) {
+                AWSLogError(@"SQLite error. Rolling back... [%@]", db.lastError);
+                error = db.lastError;
+                *rollback = YES;
+                return;
+            }
+            unsigned long long expiredBytes = [rs next] ? [rs unsignedLongLongIntForColumn:@"bytes"] : 0;
+            [rs close];
 
-        if (!error && diskAgeLimit > 0) {
-            [databaseQueue inDatabase:^(AWSFMDatabase *db) {
-                // Deletes old records exceeding the threshold.
+            if (expiredBytes > 0) {
                 BOOL result = [db executeUpdate:
                                @"DELETE FROM record "
                                @"WHERE timestamp < :timestamp"
-                        withParameterDictionary:@{
-                                                  @"timestamp" : @([[NSDate date] timeIntervalSince1970] - diskAgeLimit)
-                                                  }
-                               ];
+                        withParameterDictionary:parameters];
                 if (!result) {
-                    AWSLogError(@"SQLite error. [%@]", db.lastError);
+                    AWSLogError(@"SQLite error. Rolling back... [%@]", db.lastError);
                     error = db.lastError;
+                    *rollback = YES;
+                    return;
                 }
-            }];
-        }
-
-        if (error) {
-            return [AWSTask taskWithError:error];
+                recordBytesUsed -= MIN(expiredBytes, recordBytesUsed);
+                recordDeleted = YES;
+            }
         }
 
-        NSDictionary *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:databasePath
-                                                                                    error:&error];
-        if (attributes) {
-            unsigned long long fileSize = [attributes fileSize];
-            if (notificationByteThreshold > 0
-                && fileSize > notificationByteThreshold) {
-                // Sends out a notification if it exceeds the disk size threshold.
-                [[NSNotificationCenter defaultCenter] postNotificationName:AWSKinesisRecorderByteThresholdReachedNotification
-                                                                    object:kinesisRecorder
-                                                                  userInfo:@{AWSKinesisRecorderByteThresholdReachedNotificationDiskBytesUsedKey : @(fileSize)}];
-            }
-            if (fileSize > diskByteLimit) {
-                // Deletes the oldest record if it exceeds the disk size threshold.
-                [databaseQueue inDatabase:^(AWSFMDatabase *db) {
-                    BOOL result = [db executeUpdate:
-                                   @"DELETE FROM record "
-                                   @"WHERE rowid IN ( "
-                                   @"SELECT rowid "
-                                   @"FROM record "
-                                   @"ORDER BY rowid ASC "
-                                   @"LIMIT 1 "
-                                   @")"
-                                   ];
-                    if (!result) {
-                        AWSLogError(@"SQLite error. [%@]", db.lastError);
-                        error = db.lastError;
-                        return;
-                    }
-                }];
+        if (diskByteLimit > 0 && recordBytesUsed > diskByteLimit) {
+            // Deletes the oldest records until the stored records fit in the limit again.
+            unsigned long long bytesToEvict = recordBytesUsed - diskByteLimit;
+            unsigned long long evictedBytes = 0;
+            long long lastEvictedRowId = -1;
+            AWSFMResultSet *rs = [db executeQuery:[NSString stringWithFormat:
+                                                   @"SELECT rowid, %@ AS bytes "
+                                                   @"FROM record "
+                                                   @"ORDER BY rowid ASC", AWSKinesisRecorderRecordBytesExpression()]];
+            if (!rs) {
+                AWSLogError(@"SQLite error. Rolling back... [%@]", db.lastError);
+                error = db.lastError;
+                *rollback = YES;
+                return;
+            }
+            while (evictedBytes < bytesToEvict && [rs next]) {
+                evictedBytes += [rs unsignedLongLongIntForColumn:@"bytes"];
+                lastEvictedRowId = [rs longLongIntForColumn:@"rowid"];
+            }
+            [rs close];
 
+            if (lastEvictedRowId >= 0) {
+                BOOL result = [db executeUpdate:
+                               @"DELETE FROM record "
+                               @"WHERE rowid <= :rowid"
+                        withParameterDictionary:@{@"rowid" : @(lastEvictedRowId)}];
+                if (!result) {
+                    AWSLogError(@"SQLite error. Rolling back... [%@]", db.lastError);
+                    error = db.lastError;
+                    *rollback = YES;
+                    return;
+                }
+                recordBytesUsed -= MIN(evictedBytes, recordBytesUsed);
+                recordDeleted = YES;
             }
-        } else if (error) {
-            return [AWSTask taskWithError:error];
         }
 
-        return nil;
+        self.recordBytesUsed = recordBytesUsed;
     }];
+
+    if ([records count] == 0) {
+        return;
+    }
+
+    if (!error && recordDeleted) {
+        [self scheduleStorageMaintenance];
+    }
+
+    if (!error
+        && notificationByteThreshold > 0
+        && recordBytesUsed > notificationByteThreshold) {
+        // Sends out a notification if it exceeds the disk size threshold.
+        [[NSNotificationCenter defaultCenter] postNotificationName:AWSKinesisRecorderByteThresholdReachedNotification
+                                                            object:self
+                                                          userInfo:@{AWSKinesisRecorderByteThresholdReachedNotificationDiskBytesUsedKey : @(recordBytesUsed)}];
+    }
+
+    for (AWSTaskCompletionSource *completionSource in completionSources) {
+        if (error) {
+            [completionSource setError:error];
+        } else {
+            [completionSource setResult:nil];
+        }
+    }
 }
 
 - (AWSTask *)submitAllRecords {
-    AWSFMDatabaseQueue *databaseQueue = self.databaseQueue;
-    AWSKinesis *kinesis = self.kinesis;
+    return [[AWSTask taskWithResult:nil] continueWithExecutor:self.executor withSuccessBlock:^id(AWSTask *task) {
+        [self flushPendingRecords];
 
-    return [[AWSTask taskWithResult:nil] continueWithSuccessBlock:^id(AWSTask *task) {
         __block NSError *error = nil;
-        __block AWSTask *outputTask = [AWSTask taskWithResult:nil];
-
-        [databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
+        NSMutableArray *streamNames = [NSMutableArray new];
+        [self.databaseQueue inDatabase:^(AWSFMDatabase *db) {
             AWSFMResultSet *rs = [db executeQuery:
-                               @"SELECT stream_name "
-                               @"FROM record "
-                               @"GROUP BY stream_name "];
+                                  @"SELECT DISTINCT stream_name "
+                                  @"FROM record"];
             if (!rs) {
-                AWSLogError(@"SQLite error. Rolling back... [%@]", db.lastError);
+                AWSLogError(@"SQLite error. [%@]", db.lastError);
                 error = db.lastError;
-                *rollback = YES;
                 return;
             }
-
-            NSMutableArray *streamNames = [NSMutableArray new];
             while ([rs next]) {
                 [streamNames addObject:[rs stringForColumn:@"stream_name"]];
             }
-            rs = nil;
-            AWSLogDebug(@"Stream names: [%@]", streamNames);
-
-            for (NSString *streamName in streamNames) {
-                NSMutableArray *records = nil;
-                NSMutableArray *rowIds = nil;
-                NSNumber *startingRowId = @(-1);
-                do {
-                    AWSFMResultSet *rs = [db executeQuery:
-                                       @"SELECT rowid, partition_key, data, retry_count "
-                                       @"FROM record "
-                                       @"WHERE stream_name = :stream_name "
-                                       @"AND rowid > :rowid "
-                                       @"ORDER BY rowid ASC "
-                                       @"LIMIT 100"
-                               withParameterDictionary:@{
-                                                         @"stream_name" : streamName,
-                                                         @"rowid" : startingRowId
-                                                         }];
-                    if (!rs) {
-                        AWSLogError(@"SQLite error. Rolling back... [%@]", db.lastError);
-                        error = db.lastError;
-                        *rollback = YES;
-                        return;
-                    }
+            [rs close];
+        }];
+        if (error) {
+            return [AWSTask taskWithError:error];
+        }
+        AWSLogDebug(@"Stream names: [%@]", streamNames);
 
-                    records = [NSMutableArray new];
-                    rowIds = [NSMutableArray new];
-                    while ([rs next]) {
-                        AWSKinesisPutRecordsRequestEntry *requestEntry = [AWSKinesisPutRecordsRequestEntry new];
-                        requestEntry.partitionKey = [rs stringForColumn:@"partition_key"];
-                        requestEntry.data = [rs dataForColumn:@"data"];
-                        [records addObject:requestEntry];
+        // Starts up to `maxConcurrentSubmissionsPerStream` pipelines per stream. Each pipeline reads its next batch while its current PutRecords request is in flight.
+        AWSKinesisRecorderSubmission *submission = [AWSKinesisRecorderSubmission new];
+        NSUInteger maxConcurrentSubmissions = MAX(self.maxConcurrentSubmissionsPerStream, 1);
+        NSMutableArray *pipelines = [NSMutableArray new];
+        for (NSString *streamName in streamNames) {
+            for (NSUInteger i = 0; i < maxConcurrentSubmissions; i++) {
+                AWSKinesisRecorderBatch *batch = [self nextBatchForStreamName:streamName
+                                                                   submission:submission];
+                if (!batch) {
+                    break;
+                }
+                [pipelines addObject:[self submitBatch:batch
+                                            submission:submission]];
+            }
+        }
 
-                        startingRowId = @([rs longLongIntForColumn:@"rowid"]);
-                        [rowIds addObject:@([rs longLongIntForColumn:@"rowid"])];
-                    }
-                    rs = nil;
-
-                    if ([records count] > 0) {
-                        AWSKinesisPutRecordsInput *putRecordsInput = [AWSKinesisPutRecordsInput new];
-                        putRecordsInput.streamName = streamName;
-                        putRecordsInput.records = records;
-                        AWSLogVerbose(@"putRecordsInput: [%@]", putRecordsInput);
-                        outputTask = [outputTask continueWithSuccessBlock:^id(AWSTask *task) {
-                            return [[kinesis putRecords:putRecordsInput] continueWithSuccessBlock:^id(AWSTask *task) {
-                                if (task.error) {
-                                    AWSLogError(@"Error: [%@]", task.error);
-                                }
-                                if (task.exception) {
-                                    AWSLogError(@"Exception: [%@]", task.exception);
-                                }
-                                if (task.result) {
-                                    [databaseQueue inDatabase:^(AWSFMDatabase *db) {
-                                        AWSKinesisPutRecordsOutput *putRecordsOutput = task.result;
-                                        for (int i = 0; i < [putRecordsOutput.records count]; i++) {
-                                            AWSKinesisPutRecordsResultEntry *resultEntry = putRecordsOutput.records[i];
-                                            if (resultEntry.errorCode) {
-                                                AWSLogInfo(@"Error Code: [%@] Error Message: [%@]", resultEntry.errorCode, resultEntry.errorMessage);
-                                            }
-                                            // When the error code is ProvisionedThroughputExceededException or InternalFailure,
-                                            // we should retry. So, don't delete the row from the database.
-                                            if (![resultEntry.errorCode isEqualToString:@"ProvisionedThroughputExceededException"]
-                                                && ![resultEntry.errorCode isEqualToString:@"InternalFailure"]) {
-                                                BOOL result = [db executeUpdate:@"DELETE FROM record WHERE rowid = :rowid"
-                                                        withParameterDictionary:@{
-                                                                                  @"rowid" : rowIds[i]
-                                                                                  }];
-                                                if (!result) {
-                                                    AWSLogError(@"SQLite error. [%@]", db.lastError);
-                                                    error = db.lastError;
-                                                }
-                                            }
-                                        }
-                                    }];
-                                }
-                                return nil;
-                            }];
-                        }];
-                    }
-                } while ([records count] == 100);
+        return [[AWSTask taskForCompletionOfAllTasks:pipelines] continueWithExecutor:self.executor withBlock:^id(AWSTask *task) {
+            // The space freed by the submitted records is reclaimed once the recorder goes idle.
+            [self scheduleStorageMaintenance];
+
+            if (submission.error) {
+                return [AWSTask taskWithError:submission.error];
             }
+            return nil;
         }];
+    }];
+}
+
+/**
+ Reads the records following the ones already handed out for the stream, up to the PutRecords limits of 500 records and 5MB. Returns nil when there are no records left or the submission has stopped.
+
+ With aggregation, records are packed per shard like the Kinesis Producer Library does, and each aggregated record carries the starting hash key of its shard as its explicit hash key. Until the shards of the stream are known, records are packed per partition key instead.
+ */
+- (AWSKinesisRecorderBatch *)nextBatchForStreamName:(NSString *)streamName
+                                         submission:(AWSKinesisRecorderSubmission *)submission {
+    if (submission.error) {
+        return nil;
+    }
+
+    BOOL aggregatesRecords = self.aggregatesRecords;
+    NSData *hashKeyRanges = nil;
+    NSArray *startingHashKeys = nil;
+    if (aggregatesRecords) {
+        AWSKinesisRecorderShardPartitionKeys *shardPartitionKeys = [self shardPartitionKeysForStreamName:streamName];
+        @synchronized(shardPartitionKeys) {
+            hashKeyRanges = shardPartitionKeys.hashKeyRanges;
+            startingHashKeys = shardPartitionKeys.startingHashKeys;
+        }
+    }
+
+    __block AWSKinesisRecorderBatch *batch = nil;
+    // The database queue is serial, so reading the batch and advancing the stream position is atomic for the pipelines sharing the stream.
+    [self.databaseQueue inDatabase:^(AWSFMDatabase *db) {
+        NSNumber *startingRowId = submission.lastRowIds[streamName] ?: @(-1);
+        AWSFMResultSet *rs = [db executeQuery:
+                              @"SELECT rowid, partition_key, data, retry_count "
+                              @"FROM record "
+                              @"WHERE stream_name = :stream_name "
+                              @"AND rowid > :rowid "
+                              @"ORDER BY rowid ASC "
+                              @"LIMIT :limit"
+                      withParameterDictionary:@{
+                                                @"stream_name" : streamName,
+                                                @"rowid" : startingRowId,
+                                                // An aggregated batch can hold any number of rows; the loop stops at the request limits.
+                                                @"limit" : aggregatesRecords ? @(-1) : @(AWSKinesisRecorderPutRecordsCountLimit)
+                                                }];
+        if (!rs) {
+            AWSLogError(@"SQLite error. [%@]", db.lastError);
+            [submission stopWithError:db.lastError];
+            return;
+        }
+
+        AWSKinesisRecorderBatch *nextBatch = [AWSKinesisRecorderBatch new];
+        nextBatch.streamName = streamName;
+        // The open aggregated record and its entry index per shard index, or per partition key while the shards are unknown.
+        NSMutableDictionary *aggregatedRecords = [NSMutableDictionary new];
+        NSMutableDictionary *entryIndexes = [NSMutableDictionary new];
+        NSNumber *lastRowId = nil;
+        while ([rs next]) {
+            NSString *partitionKey = [rs stringForColumn:@"partition_key"];
+            NSData *data = [rs dataForColumn:@"data"];
+            NSNumber *rowId = @([rs longLongIntForColumn:@"rowid"]);
+            int retryCount = [rs intForColumn:@"retry_count"];
+            unsigned long long recordBytes = AWSKinesisRecorderRecordBytes(data, partitionKey, streamName);
+            NSUInteger partitionKeyBytes = [partitionKey lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+
+            NSUInteger entryBytes = [data length] + partitionKeyBytes;
+            AWSKinesisAggregatedRecord *aggregatedRecord = nil;
+            id<NSCopying> aggregationKey = nil;
+            if (aggregatesRecords) {
+                aggregationKey = partitionKey;
+                NSUInteger shardIndex = hashKeyRanges ? AWSKinesisRecorderShardIndexForPartitionKey(partitionKey, hashKeyRanges) : NSNotFound;
+                if (shardIndex != NSNotFound) {
+                    aggregationKey = @(shardIndex);
+                }
+
+                aggregatedRecord = aggregatedRecords[aggregationKey];
+                if (aggregatedRecord) {
+                    // Adds the record to the open aggregated record of its shard if both the aggregated record and the request stay within their limits.
+                    NSUInteger entryIndex = [entryIndexes[aggregationKey] unsignedIntegerValue];
+                    NSUInteger aggregatedRecordBytes = [aggregatedRecord sizeByAddingData:data partitionKey:partitionKey]
+                    + [aggregatedRecord.partitionKey lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+                    if (aggregatedRecordBytes <= AWSKinesisAggregatedRecordMaximumSize
+                        && nextBatch.byteCount - [nextBatch.entryBytes[entryIndex] unsignedIntegerValue] + aggregatedRecordBytes <= AWSKinesisRecorderPutRecordsByteLimit) {
+                        [aggregatedRecord addData:data partitionKey:partitionKey];
+                        [nextBatch addRowId:rowId toEntryAtIndex:entryIndex retryCount:retryCount recordBytes:recordBytes entryBytes:aggregatedRecordBytes];
+                        lastRowId = rowId;
+                        continue;
+                    }
+                    [nextBatch closeAggregatedRecord:aggregatedRecord
+                                      ofEntryAtIndex:entryIndex
+                                     explicitHashKey:AWSKinesisRecorderExplicitHashKeyForAggregationKey(aggregationKey, startingHashKeys)];
+                    [aggregatedRecords removeObjectForKey:aggregationKey];
+                    [entryIndexes removeObjectForKey:aggregationKey];
+                }
+
+                aggregatedRecord = [AWSKinesisAggregatedRecord new];
+                entryBytes = [aggregatedRecord sizeByAddingData:data partitionKey:partitionKey] + partitionKeyBytes;
+            }
+            if ([nextBatch.records count] >= AWSKinesisRecorderPutRecordsCountLimit
+                || ([nextBatch.records count] > 0 && nextBatch.byteCount + entryBytes > AWSKinesisRecorderPutRecordsByteLimit)) {
+                // Leaves the record and the ones after it for the next batch, so that the rows of a batch stay consecutive.
+                break;
+            }
+
+            AWSKinesisPutRecordsRequestEntry *requestEntry = [AWSKinesisPutRecordsRequestEntry new];
+            requestEntry.partitionKey = partitionKey;
+            requestEntry.data = data;
+            if (aggregatedRecord) {
+                [aggregatedRecord addData:data partitionKey:partitionKey];
+                aggregatedRecords[aggregationKey] = aggregatedRecord;
+                entryIndexes[aggregationKey] = @([nextBatch.records count]);
+            }
+            [nextBatch addEntry:requestEntry rowId:rowId retryCount:retryCount recordBytes:recordBytes entryBytes:entryBytes];
+            lastRowId = rowId;
+        }
+        [rs close];
+        for (id<NSCopying> aggregationKey in aggregatedRecords) {
+            [nextBatch closeAggregatedRecord:aggregatedRecords[aggregationKey]
+                              ofEntryAtIndex:[entryIndexes[aggregationKey] unsignedIntegerValue]
+                             explicitHashKey:AWSKinesisRecorderExplicitHashKeyForAggregationKey(aggregationKey, startingHashKeys)];
+        }
+
+        if (lastRowId) {
+            submission.lastRowIds[streamName] = lastRowId;
+            batch = nextBatch;
+        }
+    }];
+
+    return batch;
+}
+
+- (AWSTask *)submitBatch:(AWSKinesisRecorderBatch *)batch
+              submission:(AWSKinesisRecorderSubmission *)submission {
+    if (!batch || submission.error) {
+        return [AWSTask taskWithResult:nil];
+    }
+
+    AWSKinesisPutRecordsInput *putRecordsInput = [AWSKinesisPutRecordsInput new];
+    putRecordsInput.streamName = batch.streamName;
+    putRecordsInput.records = batch.records;
+    AWSLogVerbose(@"putRecordsInput: [%@]", putRecordsInput);
+    AWSTask *putRecordsTask = [self.kinesis putRecords:putRecordsInput];
+
+    // Reads the next batch while the request is in flight.
+    AWSKinesisRecorderBatch *nextBatch = [self nextBatchForStreamName:batch.streamName
+                                                           submission:submission];
 
+    return [putRecordsTask continueWithExecutor:self.executor withBlock:^id(AWSTask *task) {
+        if (task.error) {
+            // Stops every pipeline, e.g. when the device is offline. The records are kept for the next submission.
+            AWSLogError(@"Error: [%@]", task.error);
+            [submission stopWithError:task.error];
+            return nil;
+        }
+        if (task.exception) {
+            AWSLogError(@"Exception: [%@]", task.exception);
+            [submission stopWithError:[NSError errorWithDomain:AWSKinesisRecorderErrorDomain
+                                                          code:AWSKinesisRecorderErrorUnknown
+                                                      userInfo:@{NSLocalizedDescriptionKey : [task.exception description]}]];
+            return nil;
+        }
+        if (task.result) {
+            NSError *error = [self removeSubmittedRecordsOfBatch:batch
+                                                putRecordsOutput:task.result];
+            if (error) {
+                [submission stopWithError:error];
+                return nil;
+            }
+        }
+
+        return [self submitBatch:nextBatch
+                      submission:submission];
+    }];
+}
+
+/**
+ Deletes the rows accepted by Kinesis and increments `retry_count` of the rows to be retried, in one transaction.
+
+ The rows of a batch are consecutive rows of its stream, so each run of rows with the same outcome, in rowid order, maps to a single `rowid BETWEEN` statement. The rows of an aggregated entry need not be consecutive, since records are packed per shard.
+ */
+- (NSError *)removeSubmittedRecordsOfBatch:(AWSKinesisRecorderBatch *)batch
+                          putRecordsOutput:(AWSKinesisPutRecordsOutput *)putRecordsOutput {
+    NSUInteger recordRetryLimit = self.recordRetryLimit;
+    NSUInteger count = MIN([putRecordsOutput.records count], [batch.records count]);
+
+    // YES when the rows of the entry are to be deleted, NO when they are to be retried.
+    BOOL *shouldDelete = calloc(MAX(count, 1), sizeof(BOOL));
+    unsigned long long deletedBytes = 0;
+    for (NSUInteger i = 0; i < count; i++) {
+        AWSKinesisPutRecordsResultEntry *resultEntry = putRecordsOutput.records[i];
+        if (resultEntry.errorCode) {
+            AWSLogInfo(@"Error Code: [%@] Error Message: [%@]", resultEntry.errorCode, resultEntry.errorMessage);
+        }
+        // When the error code is ProvisionedThroughputExceededException or InternalFailure,
+        // we should retry. So, don't delete the row from the database unless it has been retried too many times.
+        shouldDelete[i] = YES;
+        if ([resultEntry.errorCode isEqualToString:@"ProvisionedThroughputExceededException"]
+            || [resultEntry.errorCode isEqualToString:@"InternalFailure"]) {
+            shouldDelete[i] = (recordRetryLimit > 0 && [batch.retryCounts[i] unsignedIntegerValue] + 1 >= recordRetryLimit);
+            if (shouldDelete[i]) {
+                AWSLogWarn(@"Discarding a record that has been retried %lu times.", (unsigned long)recordRetryLimit);
+            }
+        }
+        if (shouldDelete[i]) {
+            deletedBytes += [batch.recordBytes[i] unsignedLongLongValue];
+        }
+    }
+
+    // The outcome of each row of the batch. The rows of entries missing from the output are kept as they are.
+    NSMutableDictionary *rowOutcomes = [NSMutableDictionary new];
+    for (NSUInteger i = 0; i < [batch.records count]; i++) {
+        NSNumber *outcome = i < count ? @(shouldDelete[i] ? AWSKinesisRecorderRowOutcomeDelete : AWSKinesisRecorderRowOutcomeRetry) : @(AWSKinesisRecorderRowOutcomeKeep);
+        for (NSNumber *rowId in batch.rowIds[i]) {
+            rowOutcomes[rowId] = outcome;
+        }
+    }
+    free(shouldDelete);
+    NSArray *rowIds = [[rowOutcomes allKeys] sortedArrayUsingSelector:@selector(compare:)];
+
+    __block NSError *error = nil;
+    [self.databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
+        NSUInteger rowCount = [rowIds count];
+        NSUInteger runStart = 0;
+        while (runStart < rowCount) {
+            AWSKinesisRecorderRowOutcome outcome = [rowOutcomes[rowIds[runStart]] integerValue];
+            NSUInteger runEnd = runStart;
+            while (runEnd + 1 < rowCount && [rowOutcomes[rowIds[runEnd + 1]] integerValue] == outcome) {
+                runEnd++;
+            }
+
+            NSDictionary *parameters = @{
+                                         @"stream_name" : batch.streamName,
+                                         @"first_rowid" : rowIds[runStart],
+                                         @"last_rowid" : rowIds[runEnd]
+                                         };
+            BOOL result = YES;
+            if (outcome == AWSKinesisRecorderRowOutcomeDelete) {
+                result = [db executeUpdate:
+                          @"DELETE FROM record "
+                          @"WHERE stream_name = :stream_name "
+                          @"AND rowid BETWEEN :first_rowid AND :last_rowid"
+                   withParameterDictionary:parameters];
+            } else if (outcome == AWSKinesisRecorderRowOutcomeRetry) {
+                result = [db executeUpdate:
+                          @"UPDATE record "
+                          @"SET retry_count = retry_count + 1 "
+                          @"WHERE stream_name = :stream_name "
+                          @"AND rowid BETWEEN :first_rowid AND :last_rowid"
+                   withParameterDictionary:parameters];
+            }
+            if (!result) {
+                AWSLogError(@"SQLite error. Rolling back... [%@]", db.lastError);
+                error = db.lastError;
+                *rollback = YES;
+                return;
+            }
+
+            runStart = runEnd + 1;
+        }
+
+        self.recordBytesUsed -= MIN(deletedBytes, self.recordBytesUsed);
+        self.lastWriteTime = CFAbsoluteTimeGetCurrent();
+    }];
+
+    return error;
+}
+
+- (AWSTask *)removeAllRecords {
+    AWSFMDatabaseQueue *databaseQueue = self.databaseQueue;
+    __weak AWSKinesisRecorder *kinesisRecorder = self;
+
+    return [[AWSTask taskWithResult:nil] continueWithExecutor:self.executor withSuccessBlock:^id(AWSTask *task) {
+        [kinesisRecorder flushPendingRecords];
+
+        __block NSError *error = nil;
         [databaseQueue inDatabase:^(AWSFMDatabase *db) {
-            if (![db executeStatements:@"PRAGMA auto_vacuum = FULL"]) {
-                AWSLogError(@"Failed to enable 'aut_vacuum' to 'FULL'. %@", db.lastError);
+            if (![db executeUpdate:@"DELETE FROM record"]) {
+                AWSLogError(@"SQLite error. [%@]", db.lastError);
                 error = db.lastError;
+            } else {
+                kinesisRecorder.recordBytesUsed = 0;
+                kinesisRecorder.lastWriteTime = CFAbsoluteTimeGetCurrent();
             }
-            if (![db executeUpdate:@"VACUUM"]) {
+        }];
+
+        if (error) {
+            return [AWSTask taskWithError:error];
+        }
+
+        return [kinesisRecorder reclaimDiskSpace];
+    }];
+}
+
+- (AWSTask *)reclaimablePageCount {
+    AWSFMDatabaseQueue *databaseQueue = self.databaseQueue;
+
+    return [[AWSTask taskWithResult:nil] continueWithExecutor:self.executor withSuccessBlock:^id(AWSTask *task) {
+        __block NSError *error = nil;
+        __block int freelistCount = 0;
+        [databaseQueue inDatabase:^(AWSFMDatabase *db) {
+            AWSFMResultSet *rs = [db executeQuery:@"PRAGMA freelist_count"];
+            if (!rs) {
                 AWSLogError(@"SQLite error. [%@]", db.lastError);
                 error = db.lastError;
+                return;
+            }
+            if ([rs next]) {
+                freelistCount = [rs intForColumnIndex:0];
             }
+            [rs close];
         }];
 
         if (error) {
             return [AWSTask taskWithError:error];
         }
 
-        return outputTask;
+        return [AWSTask taskWithResult:@(freelistCount)];
     }];
 }
 
-- (AWSTask *)removeAllRecords {
+- (AWSTask *)reclaimDiskSpace {
     AWSFMDatabaseQueue *databaseQueue = self.databaseQueue;
 
-    return [[AWSTask taskWithResult:nil] continueWithSuccessBlock:^id(AWSTask *task) {
+    return [[AWSTask taskWithResult:nil] continueWithExecutor:self.executor withSuccessBlock:^id(AWSTask *task) {
         __block NSError *error = nil;
         [databaseQueue inDatabase:^(AWSFMDatabase *db) {
-            if (![db executeUpdate:@"DELETE FROM record"]) {
+            if (![db executeStatements:@"PRAGMA incremental_vacuum"]) {
+                AWSLogError(@"SQLite error. [%@]", db.lastError);
+                error = db.lastError;
+                return;
+            }
+            // Moves the vacuumed pages into the database file and resets the WAL file.
+            if (![db executeStatements:AWSKinesisRecorderCheckpointStatement()]) {
                 AWSLogError(@"SQLite error. [%@]", db.lastError);
                 error = db.lastError;
-            } else {
-                if (![db executeStatements:@"PRAGMA auto_vacuum = FULL"]) {
-                    AWSLogError(@"Failed to enable 'auto_vacuum' to 'FULL'. %@", db.lastError);
-                    error = db.lastError;
-                }
-                if (![db executeUpdate:@"VACUUM"]) {
-                    AWSLogError(@"SQLite error. [%@]", db.lastError);
-                    error = db.lastError;
-                }
             }
         }];
 
@@ -405,12 +1260,67 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
     }];
 }
 
+- (void)scheduleStorageMaintenance {
+    @synchronized(self) {
+        if (self.storageMaintenanceScheduled) {
+            return;
+        }
+        self.storageMaintenanceScheduled = YES;
+    }
+
+    __weak AWSKinesisRecorder *kinesisRecorder = self;
+    AWSExecutor *executor = self.executor;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(AWSKinesisRecorderStorageMaintenanceIdleInterval * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0), ^{
+        [executor execute:^{
+            [kinesisRecorder performStorageMaintenanceStep];
+        }];
+    });
+}
+
+/**
+ Returns up to `AWSKinesisRecorderIncrementalVacuumPageCount` free pages to the file system while the recorder is idle, so that a single step never holds the database queue for long.
+ */
+- (void)performStorageMaintenanceStep {
+    @synchronized(self) {
+        self.storageMaintenanceScheduled = NO;
+    }
+
+    __block BOOL shouldReschedule = NO;
+    [self.databaseQueue inDatabase:^(AWSFMDatabase *db) {
+        if (CFAbsoluteTimeGetCurrent() - self.lastWriteTime < AWSKinesisRecorderStorageMaintenanceIdleInterval) {
+            // Still busy. Tries again later.
+            shouldReschedule = YES;
+            return;
+        }
+
+        if (![db executeStatements:[NSString stringWithFormat:@"PRAGMA incremental_vacuum(%lu)", (unsigned long)AWSKinesisRecorderIncrementalVacuumPageCount]]) {
+            AWSLogError(@"SQLite error. [%@]", db.lastError);
+            return;
+        }
+
+        int freelistCount = [db intForQuery:@"PRAGMA freelist_count"];
+        AWSLogVerbose(@"Free pages left after incremental vacuum: [%d]", freelistCount);
+        if (freelistCount > 0) {
+            shouldReschedule = YES;
+        } else if (![db executeStatements:AWSKinesisRecorderCheckpointStatement()]) {
+            AWSLogError(@"SQLite error. [%@]", db.lastError);
+        }
+    }];
+
+    if (shouldReschedule) {
+        [self scheduleStorageMaintenance];
+    }
+}
+
 - (NSUInteger)diskBytesUsed {
     NSError *error = nil;
     NSDictionary *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:self.databasePath
                                                                                 error:&error];
     if (attributes) {
-        return (NSUInteger)[attributes fileSize];
+        // Committed records that have not been checkpointed yet live in the WAL file.
+        NSDictionary *walAttributes = [[NSFileManager defaultManager] attributesOfItemAtPath:[self.databasePath stringByAppendingString:@"-wal"]
+                                                                                       error:nil];
+        return (NSUInteger)([attributes fileSize] + [walAttributes fileSize]);
     } else {
         AWSLogError(@"Error [%@]", error);
         return 0;
@@ -113,8 +113,11 @@
 
     //adapt the body
     if ([theRequest postBody]) {
-        NSData *unzippedBody = [[theRequest postBody] awsgzip_gunzippedData];
-        NSArray *sourceEventsArray = [NSJSONSerialization JSONObjectWithData:unzippedBody options:kNilOptions error:NULL];
+        //parse the events while the body is inflated, instead of inflating it into memory first
+        AWSGUNZIPInputStream *unzippedBodyStream = [[AWSGUNZIPInputStream alloc] initWithInputStream:[NSInputStream inputStreamWithData:[theRequest postBody]]];
+        [unzippedBodyStream open];
+        NSArray *sourceEventsArray = [NSJSONSerialization JSONObjectWithStream:unzippedBodyStream options:kNilOptions error:NULL];
+        [unzippedBodyStream close];
         NSAssert([sourceEventsArray isKindOfClass:[NSArray class]] , @"invalid postBody: postBody should be an array");
 
         NSMutableArray *parsedEventsArray = [NSMutableArray new];
@@ -162,7 +165,8 @@
     response.originatingRequest = request;
 
     NSDate* requestStartDate = [NSDate date];
-    [[[ers putEvents:putEventInput] continueWithBlock:^id(AWSTask *task) {
+    AWSExecutor *executor = ers.configuration.executor ?: [AWSExecutor defaultExecutor];
+    [[[ers putEvents:putEventInput] continueWithExecutor:executor withBlock:^id(AWSTask *task) {
 
         NSDictionary *resultDictionary = nil;
         if (task.error) {
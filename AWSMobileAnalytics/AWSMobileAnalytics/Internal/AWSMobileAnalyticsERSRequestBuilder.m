@@ -17,6 +17,7 @@
 #import "AWSMobileAnalyticsConstants.h"
 #import "AWSMobileAnalyticsConfigurationKeys.h"
 #import "AWSGZIP.h"
+#import "AWSLogging.h"
 #import "AWSMobileAnalyticsSerializable.h"
 #import "AWSMobileAnalyticsSerializerFactory.h"
 
@@ -73,35 +74,49 @@ static NSString* const CONTENT_ENCODING_KEY = @"Content-Encoding";
     
     [request setMethod:POST];
     
-    NSData* jsonData = [self createBodyFromObjects:theObjects];
-
-    // compress the string and set the compressed header
-    NSData* compressedBody = [jsonData awsgzip_gzippedData];
+    // compress the body and set the compressed header
+    NSData* compressedBody = [self compressedBodyFromObjects:theObjects];
     [request setPostBody:compressedBody];
     [request addHeader:@"gzip" forName:CONTENT_ENCODING_KEY];
     
     return request;
 }
 
-- (NSData *)createBodyFromObjects:(NSArray *)theObjects
+- (NSData *)compressedBodyFromObjects:(NSArray *)theObjects
 {
-    // use the array of strings to build an array of JSON
-    NSMutableString* jsonArray = [[NSMutableString alloc] init];
-    [jsonArray appendString:@"["];
+    // use the array of strings to build an array of JSON, gzipped as it is written
+    // so the uncompressed batch is never held in memory
+    NSOutputStream* memoryStream = [NSOutputStream outputStreamToMemory];
+    AWSGZIPOutputStream* gzipStream = [[AWSGZIPOutputStream alloc] initWithOutputStream:memoryStream];
+    [gzipStream open];
     
-    for(int i =0; i < [theObjects count]; i++)
+    BOOL written = [self writeString:@"[" toStream:gzipStream];
+    for(int i =0; written && i < [theObjects count]; i++)
     {
         if(i)
         {
             // append the comma before items to make list generation easier
-            [jsonArray appendString:@","];
+            written = [self writeString:@"," toStream:gzipStream];
         }
-        [jsonArray appendString:[theObjects objectAtIndex:i]];
+        written = written && [self writeString:[theObjects objectAtIndex:i] toStream:gzipStream];
     }
+    written = written && [self writeString:@"]" toStream:gzipStream];
     
-    [jsonArray appendString:@"]"];
+    // closing writes the gzip trailer
+    [gzipStream close];
+    if(!written || [gzipStream streamStatus] == NSStreamStatusError)
+    {
+        AWSLogError(@"Failed to compress the events: [%@]", [gzipStream streamError]);
+        return nil;
+    }
     
-    return [jsonArray dataUsingEncoding:NSUTF8StringEncoding];
+    return [memoryStream propertyForKey:NSStreamDataWrittenToMemoryStreamKey];
+}
+
+- (BOOL)writeString:(NSString *)theString toStream:(NSOutputStream *)theStream
+{
+    NSData* data = [theString dataUsingEncoding:NSUTF8StringEncoding];
+    return [theStream write:[data bytes] maxLength:[data length]] == (NSInteger)[data length];
 }
 
 
@@ -271,6 +271,7 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
             networkingRequest.parameters = @{};
         }
         networkingRequest.shouldWriteDirectly = [[request valueForKey:@"shouldWriteDirectly"] boolValue];
+        networkingRequest.downloadingFileOffset = [request valueForKey:@"downloadingFileOffset"];
         networkingRequest.downloadingFileURL = request.downloadingFileURL;
         networkingRequest.HTTPMethod = HTTPMethod;
         networkingRequest.requestSerializer = [[AWSXMLRequestSerializer alloc] initWithJSONDefinition:[[AWSS3Resources sharedInstance] JSONObject]
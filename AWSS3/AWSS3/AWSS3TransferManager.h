@@ -49,6 +49,16 @@ typedef void (^AWSS3TransferManagerResumeAllBlock) (AWSRequest *request);
  */
 @interface AWSS3TransferManager : AWSService
 
+/**
+ The maximum number of parts uploaded concurrently by a multipart upload. The default value is 4. Setting it to 1 uploads the parts one after another.
+ */
+@property (nonatomic, assign) NSUInteger maxConcurrentUploadParts;
+
+/**
+ The maximum number of byte ranges downloaded concurrently. A download starts by requesting the first range, so an object that fits in one range takes a single request. Larger objects are split into ranges which are written into a single preallocated file, and a paused download resumes by fetching only the ranges which have not completed. The default value is 4. Setting it to 1 downloads every object with a single request.
+ */
+@property (nonatomic, assign) NSUInteger maxConcurrentDownloadRanges;
+
 /**
  Returns the singleton service client. If the singleton object does not exist, the SDK instantiates the default service client with `defaultServiceConfiguration` from `[AWSServiceManager defaultServiceManager]`. The reference to this object is maintained by the SDK, and you do not need to retain it manually.
 
@@ -236,6 +246,11 @@ typedef void (^AWSS3TransferManagerResumeAllBlock) (AWSRequest *request);
 @property (nonatomic, assign, readonly) AWSS3TransferManagerRequestState state;
 @property (nonatomic, strong) NSURL *body;
 
+/**
+ The size in bytes of each part of a multipart upload. When `nil`, the transfer manager chooses the part size from the file size and the throughput observed for earlier parts. The value is raised to 5MB, or to the size which keeps the upload within 10,000 parts, if it is smaller, and lowered to 5GB if it is larger. Files no larger than the part size are uploaded with a single request.
+ */
+@property (nonatomic, strong) NSNumber *partSize;
+
 @end
 
 @interface AWSS3TransferManagerUploadOutput : AWSS3PutObjectOutput
@@ -20,8 +20,15 @@
 #import "AWSCategory.h"
 #import "AWSLogging.h"
 #import "AWSSynchronizedMutableDictionary.h"
+#import "AWSFileRangeInputStream.h"
 
 NSUInteger const AWSS3TransferManagerMinimumPartSize = 5 * 1024 * 1024; // 5MB
+unsigned long long const AWSS3TransferManagerMaximumPartSize = 5ULL * 1024 * 1024 * 1024; // 5GB, the largest part S3 accepts
+NSUInteger const AWSS3TransferManagerMaximumPartCount = 10000;
+NSTimeInterval const AWSS3TransferManagerTargetPartUploadDuration = 10.0; // Adaptive parts are sized to take about 10 seconds each.
+NSUInteger const AWSS3TransferManagerDefaultConcurrentUploadParts = 4;
+NSUInteger const AWSS3TransferManagerDownloadRangeSize = 8 * 1024 * 1024; // 8MB
+NSUInteger const AWSS3TransferManagerDefaultConcurrentDownloadRanges = 4;
 NSString *const AWSS3TransferManagerCacheName = @"com.amazonaws.AWSS3TransferManager.CacheName";
 NSString *const AWSS3TransferManagerErrorDomain = @"com.amazonaws.AWSS3TransferManagerErrorDomain";
 NSUInteger const AWSS3TransferManagerByteLimitDefault = 5 * 1024 * 1024; // 5MB
@@ -31,6 +38,7 @@ NSTimeInterval const AWSS3TransferManagerAgeLimitDefault = 0.0; // Keeps the dat
 
 @property (nonatomic, strong) AWSS3 *s3;
 @property (nonatomic, strong) AWSTMCache *cache;
+@property (atomic, assign) double partUploadThroughput; // bytes per second of a single part upload, 0 until a part has completed
 
 @end
 
@@ -38,10 +46,11 @@ NSTimeInterval const AWSS3TransferManagerAgeLimitDefault = 0.0; // Keeps the dat
 
 @property (nonatomic, assign) AWSS3TransferManagerRequestState state;
 @property (nonatomic, assign) NSUInteger currentUploadingPartNumber;
+@property (nonatomic, assign) unsigned long long multipartPartSize;
 @property (nonatomic, strong) NSMutableArray *completedPartsArray;
 @property (nonatomic, strong) NSString *uploadId;
 @property (nonatomic, strong) NSString *cacheIdentifier;
-@property (atomic, strong) AWSS3UploadPartRequest *currentUploadingPart;
+@property (atomic, strong) AWSSynchronizedMutableDictionary *currentUploadingParts;
 
 @property (atomic, assign) int64_t totalSuccessfullySentPartsDataLength;
 @end
@@ -52,6 +61,11 @@ NSTimeInterval const AWSS3TransferManagerAgeLimitDefault = 0.0; // Keeps the dat
 @property (nonatomic, strong) NSURL *originalFileURL;
 @property (nonatomic, assign) AWSS3TransferManagerRequestState state;
 @property (nonatomic, strong) NSString *cacheIdentifier;
+@property (nonatomic, assign) unsigned long long downloadRangeSize;
+@property (nonatomic, assign) unsigned long long objectSize;
+@property (nonatomic, strong) NSString *objectETag;
+@property (nonatomic, strong) NSIndexSet *completedRanges;
+@property (atomic, strong) AWSSynchronizedMutableDictionary *currentDownloadingRanges;
 
 @end
 
@@ -122,6 +136,9 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
                                       rootPath:[NSTemporaryDirectory() stringByAppendingPathComponent:AWSS3TransferManagerCacheName]];
         _cache.diskCache.byteLimit = AWSS3TransferManagerByteLimitDefault;
         _cache.diskCache.ageLimit = AWSS3TransferManagerAgeLimitDefault;
+
+        _maxConcurrentUploadParts = AWSS3TransferManagerDefaultConcurrentUploadParts;
+        _maxConcurrentDownloadRanges = AWSS3TransferManagerDefaultConcurrentDownloadRanges;
     }
     return self;
 }
@@ -180,13 +197,17 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
     unsigned long long fileSize = [attributes fileSize];
     __weak AWSS3TransferManager *weakSelf = self;
 
+    //choose the part size before the request is cached, so that a paused upload resumes with the same parts.
+    unsigned long long partSize = [self partSizeForUploadRequest:uploadRequest fileSize:fileSize];
+    uploadRequest.multipartPartSize = fileSize > partSize ? partSize : 0;
+
     AWSTask *task = [AWSTask taskWithResult:nil];
     task = [[[task continueWithSuccessBlock:^id(AWSTask *task) {
         [weakSelf.cache setObject:uploadRequest
                            forKey:cacheKey];
         return nil;
     }] continueWithSuccessBlock:^id(AWSTask *task) {
-        if (fileSize > AWSS3TransferManagerMinimumPartSize) {
+        if (uploadRequest.multipartPartSize > 0) {
             return [weakSelf multipartUpload:uploadRequest fileSize:fileSize cacheKey:cacheKey];
         } else {
             return [weakSelf putObject:uploadRequest fileSize:fileSize cacheKey:cacheKey];
@@ -217,6 +238,53 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
     return task;
 }
 
+- (unsigned long long)partSizeForUploadRequest:(AWSS3TransferManagerUploadRequest *)uploadRequest
+                                     fileSize:(unsigned long long)fileSize {
+    //a multipart upload which has already started must keep its part size, otherwise the completed parts would no longer line up.
+    if (uploadRequest.multipartPartSize > 0) {
+        return uploadRequest.multipartPartSize;
+    }
+    if (uploadRequest.currentUploadingPartNumber > 0) {
+        //paused before the part size was saved in the cache.
+        return AWSS3TransferManagerMinimumPartSize;
+    }
+
+    unsigned long long partSize = AWSS3TransferManagerMinimumPartSize;
+    if (uploadRequest.partSize) {
+        partSize = [uploadRequest.partSize unsignedLongLongValue];
+    } else if (self.partUploadThroughput > 0) {
+        //size the parts so that each of them takes about AWSS3TransferManagerTargetPartUploadDuration at the observed throughput,
+        //but keep enough parts for all of the concurrent workers.
+        partSize = (unsigned long long)(self.partUploadThroughput * AWSS3TransferManagerTargetPartUploadDuration);
+        NSUInteger workerCount = MAX(self.maxConcurrentUploadParts, 1);
+        partSize = MIN(partSize, (fileSize + workerCount - 1) / workerCount);
+        partSize = (partSize + 1024 * 1024 - 1) / (1024 * 1024) * (1024 * 1024); // round up to a whole MB
+    }
+
+    //S3 does not accept more than 10,000 parts or parts smaller than 5MB.
+    unsigned long long minimumPartSize = MAX((unsigned long long)AWSS3TransferManagerMinimumPartSize,
+                                             (fileSize + AWSS3TransferManagerMaximumPartCount - 1) / AWSS3TransferManagerMaximumPartCount);
+    partSize = MAX(partSize, minimumPartSize);
+    partSize = MIN(partSize, AWSS3TransferManagerMaximumPartSize);
+
+    return partSize;
+}
+
+- (void)recordPartUploadOfLength:(unsigned long long)dataLength
+                        duration:(NSTimeInterval)duration {
+    if (duration <= 0) {
+        return;
+    }
+    double throughput = dataLength / duration;
+    @synchronized (self) {
+        //exponentially weighted moving average, so that a single slow or fast part does not swing the part size.
+        if (self.partUploadThroughput > 0) {
+            throughput = 0.7 * self.partUploadThroughput + 0.3 * throughput;
+        }
+        self.partUploadThroughput = throughput;
+    }
+}
+
 - (AWSTask *)putObject:(AWSS3TransferManagerUploadRequest *)uploadRequest
              fileSize:(unsigned long long) fileSize
              cacheKey:(NSString *)cacheKey {
@@ -250,7 +318,8 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
 - (AWSTask *)multipartUpload:(AWSS3TransferManagerUploadRequest *)uploadRequest
                    fileSize:(unsigned long long) fileSize
                    cacheKey:(NSString *)cacheKey {
-    NSUInteger partCount = ceil((double)fileSize / AWSS3TransferManagerMinimumPartSize);
+    unsigned long long partSize = uploadRequest.multipartPartSize;
+    NSUInteger partCount = ceil((double)fileSize / partSize);
 
     AWSTask *initRequest = nil;
     __weak AWSS3TransferManager *weakSelf = self;
@@ -281,114 +350,55 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
             completeMultipartUploadRequest.uploadId = uploadRequest.uploadId;
         }
 
-        AWSTask *uploadPartsTask = [AWSTask taskWithResult:nil];
-        NSUInteger c = uploadRequest.currentUploadingPartNumber;
-        if (c == 0) {
-            c = 1;
+        //mark the multipart upload as initiated so that a pause before the first part finishes can still be resumed.
+        if (uploadRequest.currentUploadingPartNumber == 0) {
+            uploadRequest.currentUploadingPartNumber = 1;
+            [weakSelf.cache setObject:uploadRequest forKey:cacheKey];
         }
 
-        __block int64_t multiplePartsTotalBytesSent = 0;
-
-        for (NSUInteger i = c; i < partCount + 1; i++) {
-            uploadPartsTask = [uploadPartsTask continueWithSuccessBlock:^id(AWSTask *task) {
+        //only the parts which have not been completed yet need to be uploaded.
+        NSMutableIndexSet *pendingPartNumbers = [NSMutableIndexSet indexSetWithIndexesInRange:NSMakeRange(1, partCount)];
+        for (AWSS3CompletedPart *completedPart in uploadRequest.completedPartsArray) {
+            [pendingPartNumbers removeIndex:[completedPart.partNumber unsignedIntegerValue]];
+        }
 
-                //Cancel this task if state is canceling
-                if (uploadRequest.state == AWSS3TransferManagerRequestStateCanceling) {
-                    //return a error task
-                    NSDictionary *userInfo = @{NSLocalizedDescriptionKey: [NSString stringWithFormat:NSLocalizedString(@"S3 MultipartUpload has been cancelled.", nil)]};
-                    return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3TransferManagerErrorDomain code:AWSS3TransferManagerErrorCancelled userInfo:userInfo]];
-                }
-                //Pause this task if state is Paused
-                if (uploadRequest.state == AWSS3TransferManagerRequestStatePaused) {
+        if (!uploadRequest.currentUploadingParts) {
+            uploadRequest.currentUploadingParts = [AWSSynchronizedMutableDictionary new];
+        }
 
-                    //return an error task
-                    NSDictionary *userInfo = @{NSLocalizedDescriptionKey: [NSString stringWithFormat:NSLocalizedString(@"S3 MultipartUpload has been paused.", nil)]};
-                    return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3TransferManagerErrorDomain code:AWSS3TransferManagerErrorPaused userInfo:userInfo]];
+        //reprocess the progressFeed received from s3 client for all of the parts in flight
+        __block int64_t multiplePartsTotalBytesSent = uploadRequest.totalSuccessfullySentPartsDataLength;
+        AWSNetworkingUploadProgressBlock partUploadProgress = ^(int64_t bytesSent, int64_t totalBytesSent, int64_t totalBytesExpectedToSend) {
+            AWSNetworkingRequest *internalRequest = [uploadRequest valueForKey:@"internalRequest"];
+            if (internalRequest.uploadProgress) {
+                int64_t overallBytesSent = 0;
+                @synchronized (uploadRequest) {
+                    multiplePartsTotalBytesSent += bytesSent;
+                    overallBytesSent = multiplePartsTotalBytesSent;
                 }
+                internalRequest.uploadProgress(bytesSent, overallBytesSent, fileSize);
+            }
+        };
+
+        //start up to maxConcurrentUploadParts workers, each of them keeps pulling the next pending part until none is left.
+        NSUInteger workerCount = MIN(MAX(weakSelf.maxConcurrentUploadParts, 1), MAX([pendingPartNumbers count], 1));
+        NSMutableArray *workers = [NSMutableArray arrayWithCapacity:workerCount];
+        for (NSUInteger i = 0; i < workerCount; i++) {
+            [workers addObject:[weakSelf uploadPartsFromQueue:pendingPartNumbers
+                                                uploadRequest:uploadRequest
+                                                     uploadId:completeMultipartUploadRequest.uploadId
+                                                     fileSize:fileSize
+                                                    partCount:partCount
+                                                     cacheKey:cacheKey
+                                               uploadProgress:partUploadProgress]];
+        }
 
-                NSUInteger dataLength = i == partCount ? (NSUInteger)fileSize - ((i - 1) * AWSS3TransferManagerMinimumPartSize) : AWSS3TransferManagerMinimumPartSize;
-
-                NSFileHandle *fileHandle = [NSFileHandle fileHandleForReadingAtPath:[uploadRequest.body path]];
-                [fileHandle seekToFileOffset:(i - 1) * AWSS3TransferManagerMinimumPartSize];
-                NSData *partData = [fileHandle readDataOfLength:dataLength];
-                NSURL *tempURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]]];
-                [partData writeToURL:tempURL atomically:YES];
-                partData = nil;
-                [fileHandle closeFile];
-
-                AWSS3UploadPartRequest *uploadPartRequest = [AWSS3UploadPartRequest new];
-                uploadPartRequest.bucket = uploadRequest.bucket;
-                uploadPartRequest.key = uploadRequest.key;
-                uploadPartRequest.partNumber = @(i);
-                uploadPartRequest.body = tempURL;
-                uploadPartRequest.contentLength = @(dataLength);
-                uploadPartRequest.uploadId = output.uploadId?output.uploadId:uploadRequest.uploadId;
-                
-                //pass SSE Value
-                uploadPartRequest.SSECustomerAlgorithm = uploadRequest.SSECustomerAlgorithm;
-                uploadPartRequest.SSECustomerKey = uploadRequest.SSECustomerKey;
-                uploadPartRequest.SSECustomerKeyMD5 = uploadRequest.SSECustomerKeyMD5;
-
-                uploadRequest.currentUploadingPart = uploadPartRequest; //retain the current uploading parts for cancel/pause purpose
-
-                //reprocess the progressFeed received from s3 client
-                uploadPartRequest.uploadProgress = ^(int64_t bytesSent, int64_t totalBytesSent, int64_t totalBytesExpectedToSend) {
-
-                    AWSNetworkingRequest *internalRequest = [uploadRequest valueForKey:@"internalRequest"];
-                    if (internalRequest.uploadProgress) {
-                        int64_t previousSentDataLengh = [[uploadRequest valueForKey:@"totalSuccessfullySentPartsDataLength"] longLongValue];
-                        if (multiplePartsTotalBytesSent == 0) {
-                            multiplePartsTotalBytesSent += bytesSent;
-                            multiplePartsTotalBytesSent += previousSentDataLengh;
-                            internalRequest.uploadProgress(bytesSent,multiplePartsTotalBytesSent,fileSize);
-                        } else {
-                            multiplePartsTotalBytesSent += bytesSent;
-                            internalRequest.uploadProgress(bytesSent,multiplePartsTotalBytesSent,fileSize);
-                        }
-                    }
-                };
-
-                return [[[weakSelf.s3 uploadPart:uploadPartRequest] continueWithSuccessBlock:^id(AWSTask *task) {
-                    AWSS3UploadPartOutput *partOuput = task.result;
-
-                    AWSS3CompletedPart *completedPart = [AWSS3CompletedPart new];
-                    completedPart.partNumber = @(i);
-                    completedPart.ETag = partOuput.ETag;
-
-                    NSMutableArray *completedParts = [uploadRequest valueForKey:@"completedPartsArray"];
-
-                    if (![completedParts containsObject:completedPart]) {
-                        [completedParts addObject:completedPart];
-                    }
-
-                    int64_t totalSentLenght = [[uploadRequest valueForKey:@"totalSuccessfullySentPartsDataLength"] longLongValue];
-                    totalSentLenght += dataLength;
-
-                    [uploadRequest setValue:@(totalSentLenght) forKey:@"totalSuccessfullySentPartsDataLength"];
-
-                    //set currentUploadingPartNumber to i+1 to prevent it be downloaded again if pause happened right after parts finished.
-                    uploadRequest.currentUploadingPartNumber = i + 1;
-                    [weakSelf.cache setObject:uploadRequest forKey:cacheKey];
-
-                    return nil;
-                }] continueWithBlock:^id(AWSTask *task) {
-                    NSError *error = nil;
-                    [[NSFileManager defaultManager] removeItemAtURL:tempURL
-                                                              error:&error];
-                    if (error) {
-                        AWSLogError(@"Failed to delete a temporary file for part upload: [%@]", error);
-                    }
-
-                    if (task.error) {
-                        return [AWSTask taskWithError:task.error];
-                    } else {
-                        return nil;
-                    }
-                }];
-            }];
-        }
-
-        return uploadPartsTask;
+        return [[AWSTask taskForCompletionOfAllTasks:workers] continueWithBlock:^id(AWSTask *task) {
+            if (task.error) {
+                return [AWSTask taskWithError:[weakSelf errorFromConcurrentTransfersError:task.error]];
+            }
+            return task;
+        }];
     }] continueWithSuccessBlock:^id(AWSTask *task) {
 
         //If all parts upload succeed, send completeMultipartUpload request
@@ -432,6 +442,152 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
     return uploadTask;
 }
 
+- (AWSTask *)uploadPartsFromQueue:(NSMutableIndexSet *)pendingPartNumbers
+                    uploadRequest:(AWSS3TransferManagerUploadRequest *)uploadRequest
+                         uploadId:(NSString *)uploadId
+                         fileSize:(unsigned long long)fileSize
+                        partCount:(NSUInteger)partCount
+                         cacheKey:(NSString *)cacheKey
+                   uploadProgress:(AWSNetworkingUploadProgressBlock)uploadProgress {
+    NSUInteger partNumber = NSNotFound;
+    @synchronized (pendingPartNumbers) {
+        partNumber = [pendingPartNumbers firstIndex];
+        if (partNumber != NSNotFound) {
+            [pendingPartNumbers removeIndex:partNumber];
+        }
+    }
+    if (partNumber == NSNotFound) {
+        return [AWSTask taskWithResult:nil];
+    }
+
+    __weak AWSS3TransferManager *weakSelf = self;
+
+    return [[self uploadPart:partNumber
+               uploadRequest:uploadRequest
+                    uploadId:uploadId
+                    fileSize:fileSize
+                   partCount:partCount
+                    cacheKey:cacheKey
+              uploadProgress:uploadProgress] continueWithBlock:^id(AWSTask *task) {
+        if (task.error || task.exception || task.cancelled) {
+            //stop the other workers from picking up new parts.
+            @synchronized (pendingPartNumbers) {
+                [pendingPartNumbers removeAllIndexes];
+            }
+            return task;
+        }
+
+        return [weakSelf uploadPartsFromQueue:pendingPartNumbers
+                                uploadRequest:uploadRequest
+                                     uploadId:uploadId
+                                     fileSize:fileSize
+                                    partCount:partCount
+                                     cacheKey:cacheKey
+                               uploadProgress:uploadProgress];
+    }];
+}
+
+- (AWSTask *)uploadPart:(NSUInteger)partNumber
+          uploadRequest:(AWSS3TransferManagerUploadRequest *)uploadRequest
+               uploadId:(NSString *)uploadId
+               fileSize:(unsigned long long)fileSize
+              partCount:(NSUInteger)partCount
+               cacheKey:(NSString *)cacheKey
+         uploadProgress:(AWSNetworkingUploadProgressBlock)uploadProgress {
+    //Cancel this task if state is canceling
+    if (uploadRequest.state == AWSS3TransferManagerRequestStateCanceling) {
+        //return a error task
+        NSDictionary *userInfo = @{NSLocalizedDescriptionKey: [NSString stringWithFormat:NSLocalizedString(@"S3 MultipartUpload has been cancelled.", nil)]};
+        return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3TransferManagerErrorDomain code:AWSS3TransferManagerErrorCancelled userInfo:userInfo]];
+    }
+    //Pause this task if state is Paused
+    if (uploadRequest.state == AWSS3TransferManagerRequestStatePaused) {
+
+        //return an error task
+        NSDictionary *userInfo = @{NSLocalizedDescriptionKey: [NSString stringWithFormat:NSLocalizedString(@"S3 MultipartUpload has been paused.", nil)]};
+        return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3TransferManagerErrorDomain code:AWSS3TransferManagerErrorPaused userInfo:userInfo]];
+    }
+
+    unsigned long long partSize = uploadRequest.multipartPartSize;
+    unsigned long long dataLength = partNumber == partCount ? fileSize - (partNumber - 1) * partSize : partSize;
+
+    //the part is streamed directly from its range of the original file.
+    AWSFileRangeInputStream *partStream = [[AWSFileRangeInputStream alloc] initWithFileURL:uploadRequest.body
+                                                                                    offset:(partNumber - 1) * partSize
+                                                                                    length:dataLength];
+
+    AWSS3UploadPartRequest *uploadPartRequest = [AWSS3UploadPartRequest new];
+    uploadPartRequest.bucket = uploadRequest.bucket;
+    uploadPartRequest.key = uploadRequest.key;
+    uploadPartRequest.partNumber = @(partNumber);
+    uploadPartRequest.body = partStream;
+    uploadPartRequest.contentLength = @(dataLength);
+    uploadPartRequest.uploadId = uploadId;
+
+    //pass SSE Value
+    uploadPartRequest.SSECustomerAlgorithm = uploadRequest.SSECustomerAlgorithm;
+    uploadPartRequest.SSECustomerKey = uploadRequest.SSECustomerKey;
+    uploadPartRequest.SSECustomerKeyMD5 = uploadRequest.SSECustomerKeyMD5;
+
+    uploadPartRequest.uploadProgress = uploadProgress;
+
+    //retain the uploading parts for cancel/pause purpose
+    [uploadRequest.currentUploadingParts setObject:uploadPartRequest forKey:@(partNumber)];
+
+    __weak AWSS3TransferManager *weakSelf = self;
+    NSDate *partStartDate = [NSDate date];
+
+    return [[[weakSelf.s3 uploadPart:uploadPartRequest] continueWithSuccessBlock:^id(AWSTask *task) {
+        [weakSelf recordPartUploadOfLength:dataLength duration:-[partStartDate timeIntervalSinceNow]];
+
+        AWSS3UploadPartOutput *partOuput = task.result;
+
+        AWSS3CompletedPart *completedPart = [AWSS3CompletedPart new];
+        completedPart.partNumber = @(partNumber);
+        completedPart.ETag = partOuput.ETag;
+
+        @synchronized (uploadRequest) {
+            //keep completedPartsArray sorted by part number; it is replaced rather than mutated because the cache may still be archiving the previous array.
+            NSMutableArray *completedParts = [NSMutableArray arrayWithArray:uploadRequest.completedPartsArray];
+            NSUInteger index = [completedParts indexOfObject:completedPart
+                                               inSortedRange:NSMakeRange(0, [completedParts count])
+                                                     options:NSBinarySearchingInsertionIndex | NSBinarySearchingFirstEqual
+                                             usingComparator:^NSComparisonResult(AWSS3CompletedPart *part1, AWSS3CompletedPart *part2) {
+                                                 return [part1.partNumber compare:part2.partNumber];
+                                             }];
+            if (index == [completedParts count]
+                || ![[completedParts[index] partNumber] isEqualToNumber:completedPart.partNumber]) {
+                [completedParts insertObject:completedPart atIndex:index];
+            }
+            uploadRequest.completedPartsArray = completedParts;
+
+            uploadRequest.totalSuccessfullySentPartsDataLength += dataLength;
+
+            //set currentUploadingPartNumber to the first part which has not been completed yet.
+            NSUInteger firstIncompletePartNumber = 1;
+            for (AWSS3CompletedPart *part in completedParts) {
+                if ([part.partNumber unsignedIntegerValue] != firstIncompletePartNumber) {
+                    break;
+                }
+                firstIncompletePartNumber++;
+            }
+            uploadRequest.currentUploadingPartNumber = firstIncompletePartNumber;
+        }
+
+        [weakSelf.cache setObject:uploadRequest forKey:cacheKey];
+
+        return nil;
+    }] continueWithBlock:^id(AWSTask *task) {
+        [uploadRequest.currentUploadingParts removeObjectForKey:@(partNumber)];
+
+        if (task.error) {
+            return [AWSTask taskWithError:task.error];
+        } else {
+            return nil;
+        }
+    }];
+}
+
 - (AWSTask *)download:(AWSS3TransferManagerDownloadRequest *)downloadRequest {
     NSString *cacheKey = nil;
     if ([downloadRequest valueForKey:@"cacheIdentifier"]) {
@@ -509,8 +665,8 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
         
         //save the tempFileURL
         downloadRequest.temporaryFileURL = tempFileURL;
-    } else {
-        //if the is a paused task, set the range
+    } else if (downloadRequest.downloadRangeSize == 0) {
+        //if the is a paused task, set the range. (ranged downloads keep track of their completed ranges instead)
         NSURL *tempFileURL = downloadRequest.temporaryFileURL;
         if (tempFileURL) {
             if ([[NSFileManager defaultManager] fileExistsAtPath:tempFileURL.path] == NO) {
@@ -542,12 +698,351 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
         [weakSelf.cache setObject:downloadRequest forKey:cacheKey];
         return nil;
     }] continueWithSuccessBlock:^id(AWSTask *task) {
-        return [weakSelf getObject:downloadRequest cacheKey:cacheKey];
+        //the object is split into ranges only when the whole of it is requested.
+        if (downloadRequest.downloadRangeSize > 0
+            || (downloadRequest.range == nil && weakSelf.maxConcurrentDownloadRanges > 1)) {
+            return [weakSelf rangedDownload:downloadRequest cacheKey:cacheKey];
+        } else {
+            return [weakSelf getObject:downloadRequest cacheKey:cacheKey];
+        }
     }];
 
     return task;
 }
 
+- (AWSTask *)rangedDownload:(AWSS3TransferManagerDownloadRequest *)downloadRequest
+                   cacheKey:(NSString *)cacheKey {
+    __weak AWSS3TransferManager *weakSelf = self;
+    //the output of the head request or of the first range, used to fill in the download output.
+    __block AWSS3GetObjectOutput *objectOutput = nil;
+    __block BOOL downloadedWithSingleRequest = NO;
+
+    //a new download starts with a request for the first range, whose Content-Range tells whether the rest of the object needs to be fetched at all.
+    AWSTask *(^downloadFromFirstRange)(void) = ^AWSTask *{
+        AWSS3GetObjectRequest *getObjectRequest = [weakSelf firstRangeRequestForDownloadRequest:downloadRequest];
+        //the service client lets go of the internal request when it finishes, so it is kept here to read the response headers.
+        AWSNetworkingRequest *internalRequest = [getObjectRequest valueForKey:@"internalRequest"];
+        return [[weakSelf.s3 getObject:getObjectRequest] continueWithBlock:^id(AWSTask *task) {
+            if ([task.error.domain isEqualToString:AWSS3ErrorDomain]
+                && [task.error.userInfo[@"Code"] isEqualToString:@"InvalidRange"]) {
+                //an empty object can not be requested by range.
+                downloadedWithSingleRequest = YES;
+                return [weakSelf getObject:downloadRequest cacheKey:cacheKey];
+            }
+            if (task.error || task.exception || task.cancelled) {
+                return task;
+            }
+
+            AWSS3GetObjectOutput *firstRangeOutput = task.result;
+            objectOutput = firstRangeOutput;
+            //Content-Range looks like "bytes 0-8388607/20000000". Without it the whole object has been returned.
+            NSHTTPURLResponse *response = (NSHTTPURLResponse *)internalRequest.task.response;
+            NSString *contentRange = nil;
+            if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
+                contentRange = response.allHeaderFields[@"Content-Range"];
+            }
+            NSRange totalSizeSeparator = [contentRange rangeOfString:@"/" options:NSBackwardsSearch];
+            if (!contentRange || totalSizeSeparator.location == NSNotFound) {
+                return nil;
+            }
+            unsigned long long objectSize = strtoull([[contentRange substringFromIndex:NSMaxRange(totalSizeSeparator)] UTF8String], NULL, 10);
+            if (objectSize <= AWSS3TransferManagerDownloadRangeSize) {
+                //the first range is the whole object.
+                return nil;
+            }
+
+            //extend the file so that each of the remaining ranges can be wrote at its own offset.
+            NSError *error = nil;
+            NSFileHandle *fileHandle = [NSFileHandle fileHandleForWritingToURL:downloadRequest.temporaryFileURL error:&error];
+            if (!fileHandle) {
+                return [AWSTask taskWithError:error];
+            }
+            [fileHandle truncateFileAtOffset:objectSize];
+            [fileHandle closeFile];
+
+            downloadRequest.objectSize = objectSize;
+            downloadRequest.objectETag = firstRangeOutput.ETag;
+            downloadRequest.completedRanges = [NSIndexSet indexSetWithIndex:0];
+            downloadRequest.downloadRangeSize = AWSS3TransferManagerDownloadRangeSize;
+            [weakSelf.cache setObject:downloadRequest forKey:cacheKey];
+
+            return [weakSelf downloadRanges:downloadRequest cacheKey:cacheKey];
+        }];
+    };
+
+    AWSTask *rangesTask = nil;
+    if (downloadRequest.downloadRangeSize > 0) {
+        //a paused download has to make sure that the object has not changed before fetching the remaining ranges. The head request shares the download request's internal request so that it can be paused and cancelled.
+        AWSS3HeadObjectRequest *headObjectRequest = [AWSS3HeadObjectRequest new];
+        [headObjectRequest aws_copyPropertiesFromObject:downloadRequest];
+        headObjectRequest.range = nil;
+        headObjectRequest.downloadingFileURL = nil;
+
+        rangesTask = [[weakSelf.s3 headObject:headObjectRequest] continueWithSuccessBlock:^id(AWSTask *task) {
+            AWSS3HeadObjectOutput *headObjectOutput = task.result;
+            unsigned long long objectSize = [headObjectOutput.contentLength unsignedLongLongValue];
+
+            //start over if the object has changed since the download was paused, or if the partially downloaded file is gone.
+            if (objectSize != downloadRequest.objectSize
+                || ![headObjectOutput.ETag isEqualToString:downloadRequest.objectETag]
+                || ![[NSFileManager defaultManager] fileExistsAtPath:downloadRequest.temporaryFileURL.path]) {
+                AWSLogDebug(@"The object has changed or the downloaded ranges are missing, restarting the download.");
+                downloadRequest.downloadRangeSize = 0;
+                downloadRequest.completedRanges = nil;
+                return downloadFromFirstRange();
+            }
+
+            objectOutput = [AWSS3GetObjectOutput new];
+            [objectOutput aws_copyPropertiesFromObject:headObjectOutput];
+            return [weakSelf downloadRanges:downloadRequest cacheKey:cacheKey];
+        }];
+    } else {
+        rangesTask = downloadFromFirstRange();
+    }
+
+    AWSTask *downloadTask = [[rangesTask continueWithBlock:^id(AWSTask *task) {
+        if (downloadedWithSingleRequest) {
+            //getObject has already finished up.
+            return task;
+        }
+
+        //delete cached Object if state is not Paused
+        if (downloadRequest.state != AWSS3TransferManagerRequestStatePaused) {
+            [weakSelf.cache removeObjectForKey:cacheKey];
+        }
+
+        if (task.error) {
+            return [AWSTask taskWithError:task.error];
+        }
+
+        //If task complete without error, move the completed file to originalFileURL
+        NSURL *tempFileURL = downloadRequest.temporaryFileURL;
+        NSURL *originalFileURL = downloadRequest.originalFileURL;
+        if (originalFileURL) {
+            NSError *error = nil;
+            //delete the orginalFileURL if it already exists
+            if ([[NSFileManager defaultManager] fileExistsAtPath:originalFileURL.path]) {
+                [[NSFileManager defaultManager] removeItemAtPath:originalFileURL.path error:nil];
+            }
+            [[NSFileManager defaultManager] moveItemAtURL:tempFileURL
+                                                    toURL:originalFileURL
+                                                    error:&error];
+            if (error) {
+                //got error when try to move completed file.
+                return [AWSTask taskWithError:error];
+            }
+        }
+
+        AWSS3TransferManagerDownloadOutput *downloadOutput = [AWSS3TransferManagerDownloadOutput new];
+        [downloadOutput aws_copyPropertiesFromObject:objectOutput];
+        //describe the whole object rather than the first range.
+        if (downloadRequest.downloadRangeSize > 0) {
+            downloadOutput.contentLength = @(downloadRequest.objectSize);
+        }
+        downloadOutput.body = originalFileURL;
+
+        downloadRequest.state = AWSS3TransferManagerRequestStateCompleted;
+        [downloadRequest setValue:nil forKey:@"internalRequest"];
+        return downloadOutput;
+    }] continueWithBlock:^id(AWSTask *task) {
+        if (task.error) {
+            if ([task.error.domain isEqualToString:NSURLErrorDomain]
+                && task.error.code == NSURLErrorCancelled) {
+                if (downloadRequest.state == AWSS3TransferManagerRequestStatePaused) {
+                    return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3TransferManagerErrorDomain
+                                                                     code:AWSS3TransferManagerErrorPaused
+                                                                 userInfo:task.error.userInfo]];
+                } else {
+                    return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3TransferManagerErrorDomain
+                                                                     code:AWSS3TransferManagerErrorCancelled
+                                                                 userInfo:task.error.userInfo]];
+                }
+
+            } else {
+                return [AWSTask taskWithError:task.error];
+            }
+        } else {
+            return [AWSTask taskWithResult:task.result];
+        }
+    }];
+
+    return downloadTask;
+}
+
+- (AWSS3GetObjectRequest *)firstRangeRequestForDownloadRequest:(AWSS3TransferManagerDownloadRequest *)downloadRequest {
+    AWSS3GetObjectRequest *getObjectRequest = [AWSS3GetObjectRequest new];
+    [getObjectRequest aws_copyPropertiesFromObject:downloadRequest];
+    getObjectRequest.range = [NSString stringWithFormat:@"bytes=0-%llu", (unsigned long long)AWSS3TransferManagerDownloadRangeSize - 1];
+
+    //the range is wrote to the beginning of a new file.
+    NSURL *tempFileURL = downloadRequest.temporaryFileURL;
+    if ([[NSFileManager defaultManager] fileExistsAtPath:tempFileURL.path]) {
+        [[NSFileManager defaultManager] removeItemAtPath:tempFileURL.path error:nil];
+    }
+    getObjectRequest.downloadingFileURL = tempFileURL;
+
+    return getObjectRequest;
+}
+
+- (AWSTask *)downloadRanges:(AWSS3TransferManagerDownloadRequest *)downloadRequest
+                   cacheKey:(NSString *)cacheKey {
+    unsigned long long rangeSize = downloadRequest.downloadRangeSize;
+    NSUInteger rangeCount = (NSUInteger)((downloadRequest.objectSize + rangeSize - 1) / rangeSize);
+
+    //only the ranges which have not been completed yet need to be downloaded.
+    NSMutableIndexSet *pendingRanges = [NSMutableIndexSet indexSetWithIndexesInRange:NSMakeRange(0, rangeCount)];
+    [pendingRanges removeIndexes:downloadRequest.completedRanges];
+
+    if (!downloadRequest.currentDownloadingRanges) {
+        downloadRequest.currentDownloadingRanges = [AWSSynchronizedMutableDictionary new];
+    }
+
+    //reprocess the progressFeed received from s3 client for all of the ranges in flight
+    __block int64_t totalBytesWritten = 0;
+    NSUInteger completedRangeIndex = [downloadRequest.completedRanges firstIndex];
+    while (completedRangeIndex != NSNotFound) {
+        totalBytesWritten += MIN(rangeSize, downloadRequest.objectSize - completedRangeIndex * rangeSize);
+        completedRangeIndex = [downloadRequest.completedRanges indexGreaterThanIndex:completedRangeIndex];
+    }
+    int64_t objectSize = downloadRequest.objectSize;
+    AWSNetworkingDownloadProgressBlock rangeDownloadProgress = ^(int64_t bytesWritten, int64_t totalBytesWrittenOfRange, int64_t totalBytesExpectedToWrite) {
+        AWSNetworkingRequest *internalRequest = [downloadRequest valueForKey:@"internalRequest"];
+        if (internalRequest.downloadProgress) {
+            int64_t overallBytesWritten = 0;
+            @synchronized (downloadRequest) {
+                totalBytesWritten += bytesWritten;
+                overallBytesWritten = totalBytesWritten;
+            }
+            internalRequest.downloadProgress(bytesWritten, overallBytesWritten, objectSize);
+        }
+    };
+
+    //start up to maxConcurrentDownloadRanges workers, each of them keeps pulling the next pending range until none is left.
+    NSUInteger workerCount = MIN(MAX(self.maxConcurrentDownloadRanges, 1), MAX([pendingRanges count], 1));
+    NSMutableArray *workers = [NSMutableArray arrayWithCapacity:workerCount];
+    for (NSUInteger i = 0; i < workerCount; i++) {
+        [workers addObject:[self downloadRangesFromQueue:pendingRanges
+                                         downloadRequest:downloadRequest
+                                                cacheKey:cacheKey
+                                        downloadProgress:rangeDownloadProgress]];
+    }
+
+    __weak AWSS3TransferManager *weakSelf = self;
+
+    return [[AWSTask taskForCompletionOfAllTasks:workers] continueWithBlock:^id(AWSTask *task) {
+        if (task.error) {
+            return [AWSTask taskWithError:[weakSelf errorFromConcurrentTransfersError:task.error]];
+        }
+        if ([downloadRequest.completedRanges count] != rangeCount) {
+            NSDictionary *userInfo = @{NSLocalizedDescriptionKey:[NSString stringWithFormat:@"completedRanges count is not equal to totalRangeCount. expect %lu but got %lu",(unsigned long)rangeCount,(unsigned long)[downloadRequest.completedRanges count]]};
+            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3TransferManagerErrorDomain
+                                                             code:AWSS3TransferManagerErrorUnknown
+                                                         userInfo:userInfo]];
+        }
+        return task;
+    }];
+}
+
+- (AWSTask *)downloadRangesFromQueue:(NSMutableIndexSet *)pendingRanges
+                     downloadRequest:(AWSS3TransferManagerDownloadRequest *)downloadRequest
+                            cacheKey:(NSString *)cacheKey
+                    downloadProgress:(AWSNetworkingDownloadProgressBlock)downloadProgress {
+    NSUInteger rangeIndex = NSNotFound;
+    @synchronized (pendingRanges) {
+        rangeIndex = [pendingRanges firstIndex];
+        if (rangeIndex != NSNotFound) {
+            [pendingRanges removeIndex:rangeIndex];
+        }
+    }
+    if (rangeIndex == NSNotFound) {
+        return [AWSTask taskWithResult:nil];
+    }
+
+    __weak AWSS3TransferManager *weakSelf = self;
+
+    return [[self downloadRange:rangeIndex
+                downloadRequest:downloadRequest
+                       cacheKey:cacheKey
+               downloadProgress:downloadProgress] continueWithBlock:^id(AWSTask *task) {
+        if (task.error || task.exception || task.cancelled) {
+            //stop the other workers from picking up new ranges.
+            @synchronized (pendingRanges) {
+                [pendingRanges removeAllIndexes];
+            }
+            return task;
+        }
+
+        return [weakSelf downloadRangesFromQueue:pendingRanges
+                                 downloadRequest:downloadRequest
+                                        cacheKey:cacheKey
+                                downloadProgress:downloadProgress];
+    }];
+}
+
+- (AWSTask *)downloadRange:(NSUInteger)rangeIndex
+           downloadRequest:(AWSS3TransferManagerDownloadRequest *)downloadRequest
+                  cacheKey:(NSString *)cacheKey
+          downloadProgress:(AWSNetworkingDownloadProgressBlock)downloadProgress {
+    //Cancel this task if state is canceling
+    if (downloadRequest.state == AWSS3TransferManagerRequestStateCanceling) {
+        //return a error task
+        NSDictionary *userInfo = @{NSLocalizedDescriptionKey: [NSString stringWithFormat:NSLocalizedString(@"S3 download has been cancelled.", nil)]};
+        return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3TransferManagerErrorDomain code:AWSS3TransferManagerErrorCancelled userInfo:userInfo]];
+    }
+    //Pause this task if state is Paused
+    if (downloadRequest.state == AWSS3TransferManagerRequestStatePaused) {
+        //return an error task
+        NSDictionary *userInfo = @{NSLocalizedDescriptionKey: [NSString stringWithFormat:NSLocalizedString(@"S3 download has been paused.", nil)]};
+        return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3TransferManagerErrorDomain code:AWSS3TransferManagerErrorPaused userInfo:userInfo]];
+    }
+
+    unsigned long long rangeStart = rangeIndex * downloadRequest.downloadRangeSize;
+    unsigned long long rangeEnd = MIN(rangeStart + downloadRequest.downloadRangeSize, downloadRequest.objectSize) - 1;
+
+    AWSS3GetObjectRequest *getObjectRequest = [AWSS3GetObjectRequest new];
+    [getObjectRequest aws_copyPropertiesFromObject:downloadRequest];
+    //each range needs its own internal request to be paused and cancelled on its own.
+    [getObjectRequest setValue:[AWSNetworkingRequest new] forKey:@"internalRequest"];
+    getObjectRequest.range = [NSString stringWithFormat:@"bytes=%llu-%llu", rangeStart, rangeEnd];
+    //make sure every range comes from the same version of the object.
+    if (getObjectRequest.ifMatch == nil) {
+        getObjectRequest.ifMatch = downloadRequest.objectETag;
+    }
+
+    //write the range straight into its place in the preallocated file.
+    getObjectRequest.downloadingFileURL = downloadRequest.temporaryFileURL;
+    [getObjectRequest setValue:@YES forKey:@"shouldWriteDirectly"];
+    [getObjectRequest setValue:@(rangeStart) forKey:@"downloadingFileOffset"];
+    getObjectRequest.downloadProgress = downloadProgress;
+
+    //retain the downloading ranges for cancel/pause purpose
+    [downloadRequest.currentDownloadingRanges setObject:getObjectRequest forKey:@(rangeIndex)];
+
+    __weak AWSS3TransferManager *weakSelf = self;
+
+    return [[[weakSelf.s3 getObject:getObjectRequest] continueWithSuccessBlock:^id(AWSTask *task) {
+        @synchronized (downloadRequest) {
+            //completedRanges is replaced rather than mutated because the cache may still be archiving the previous index set.
+            NSMutableIndexSet *completedRanges = [NSMutableIndexSet indexSet];
+            [completedRanges addIndexes:downloadRequest.completedRanges];
+            [completedRanges addIndex:rangeIndex];
+            downloadRequest.completedRanges = completedRanges;
+        }
+
+        [weakSelf.cache setObject:downloadRequest forKey:cacheKey];
+
+        return nil;
+    }] continueWithBlock:^id(AWSTask *task) {
+        [downloadRequest.currentDownloadingRanges removeObjectForKey:@(rangeIndex)];
+
+        if (task.error) {
+            return [AWSTask taskWithError:task.error];
+        } else {
+            return nil;
+        }
+    }];
+}
+
 - (AWSTask *)getObject:(AWSS3TransferManagerDownloadRequest *)downloadRequest
              cacheKey:(NSString *)cacheKey {
     AWSS3GetObjectRequest *getObjectRequest = [AWSS3GetObjectRequest new];
@@ -726,6 +1221,23 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
     return taskCompletionSource.task;
 }
 
+- (NSError *)errorFromConcurrentTransfersError:(NSError *)error {
+    //surface a single error, preferring a cancellation, so that pause and cancel are still recognized by the caller.
+    if ([error.domain isEqualToString:AWSTaskErrorDomain]
+        && error.code == kAWSMultipleErrorsError) {
+        NSArray *errors = error.userInfo[@"errors"];
+        NSError *firstError = [errors firstObject];
+        for (NSError *transferError in errors) {
+            if ([transferError.domain isEqualToString:NSURLErrorDomain]
+                && transferError.code == NSURLErrorCancelled) {
+                return transferError;
+            }
+        }
+        return firstError;
+    }
+    return error;
+}
+
 - (void)abortMultipartUploadsForRequest:(AWSS3TransferManagerUploadRequest *)uploadRequest{
     AWSS3AbortMultipartUploadRequest *abortMultipartUploadRequest = [AWSS3AbortMultipartUploadRequest new];
     abortMultipartUploadRequest.bucket = uploadRequest.bucket;
@@ -761,12 +1273,11 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
     if (self.state != AWSS3TransferManagerRequestStateCompleted) {
         self.state = AWSS3TransferManagerRequestStateCanceling;
 
-        NSDictionary *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:[[self.body path] stringByResolvingSymlinksInPath]
-                                                                                    error:nil];
-        unsigned long long fileSize = [attributes fileSize];
-        if (fileSize > AWSS3TransferManagerMinimumPartSize) {
+        if (self.multipartPartSize > 0) {
             //If using multipart upload, need to cancel current parts upload and send AbortMultiPartUpload Request.
-            [self.currentUploadingPart cancel];
+            for (id partNumber in [self.currentUploadingParts allKeys]) {
+                [[self.currentUploadingParts objectForKey:partNumber] cancel];
+            }
 
         } else {
             //Otherwise, just call super to cancel current task.
@@ -792,12 +1303,11 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
             //change state to Paused
             self.state = AWSS3TransferManagerRequestStatePaused;
             //pause the current uploadTask
-            NSDictionary *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:[[self.body path] stringByResolvingSymlinksInPath]
-                                                                                        error:nil];
-            unsigned long long fileSize = [attributes fileSize];
-            if (fileSize > AWSS3TransferManagerMinimumPartSize) {
+            if (self.multipartPartSize > 0) {
                 //If using multipart upload, need to check state flag and then pause the current parts upload and save the current status.
-                [self.currentUploadingPart pause];
+                for (id partNumber in [self.currentUploadingParts allKeys]) {
+                    [[self.currentUploadingParts objectForKey:partNumber] pause];
+                }
             } else {
                 //otherwise, pause the current task. (cancel without set isCancelled flag)
                 [super pause];
@@ -809,6 +1319,14 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
     }
 }
 
+- (NSDictionary *)dictionaryValue {
+    NSMutableDictionary *mutableDictionaryValue = [[super dictionaryValue] mutableCopy];
+    //the parts in flight only live as long as the transfer is running and should not be archived into the cache.
+    [mutableDictionaryValue removeObjectForKey:@"currentUploadingParts"];
+
+    return mutableDictionaryValue;
+}
+
 @end
 
 @implementation AWSS3TransferManagerUploadOutput
@@ -828,6 +1346,10 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
 - (AWSTask *)cancel {
     if (self.state != AWSS3TransferManagerRequestStateCompleted) {
         self.state = AWSS3TransferManagerRequestStateCanceling;
+        //cancel the ranges in flight of a ranged download as well as the current task.
+        for (id rangeIndex in [self.currentDownloadingRanges allKeys]) {
+            [[self.currentDownloadingRanges objectForKey:rangeIndex] cancel];
+        }
         return [super cancel];
     }
     return [AWSTask taskWithResult:nil];
@@ -850,12 +1372,24 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
             self.state = AWSS3TransferManagerRequestStatePaused;
             //pause the current download task (i.e. cancel without set the isCancelled flag)
             [super pause];
+            //and the ranges in flight of a ranged download.
+            for (id rangeIndex in [self.currentDownloadingRanges allKeys]) {
+                [[self.currentDownloadingRanges objectForKey:rangeIndex] pause];
+            }
             return [AWSTask taskWithResult:nil];
         }
             break;
     }
 }
 
+- (NSDictionary *)dictionaryValue {
+    NSMutableDictionary *mutableDictionaryValue = [[super dictionaryValue] mutableCopy];
+    //the ranges in flight only live as long as the transfer is running and should not be archived into the cache.
+    [mutableDictionaryValue removeObjectForKey:@"currentDownloadingRanges"];
+
+    return mutableDictionaryValue;
+}
+
 @end
 
 @implementation AWSS3TransferManagerDownloadOutput
@@ -0,0 +1 @@
+../../../AWSCore/AWSCore/Utility/AWSClassMetadata.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../AWSCore/AWSCore/Serialization/AWSJSONModelMetadata.h
\ No newline at end of file
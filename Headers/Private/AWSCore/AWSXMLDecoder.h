@@ -0,0 +1 @@
+../../../AWSCore/AWSCore/Serialization/AWSXMLDecoder.h
\ No newline at end of file
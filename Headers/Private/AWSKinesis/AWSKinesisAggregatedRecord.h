@@ -0,0 +1 @@
+../../../AWSKinesis/AWSKinesis/AWSKinesisAggregatedRecord.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../AWSCore/AWSCore/Bolts/AWSCancellationToken.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../AWSCore/AWSCore/Bolts/AWSCancellationTokenSource.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../AWSCore/AWSCore/Networking/AWSFileRangeInputStream.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../AWSCore/AWSCore/Serialization/AWSJSONDecoder.h
\ No newline at end of file
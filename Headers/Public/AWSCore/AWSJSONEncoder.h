@@ -0,0 +1 @@
+../../../AWSCore/AWSCore/Serialization/AWSJSONEncoder.h
\ No newline at end of file
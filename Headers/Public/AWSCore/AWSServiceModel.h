@@ -0,0 +1 @@
+../../../AWSCore/AWSCore/Serialization/AWSServiceModel.h
\ No newline at end of file